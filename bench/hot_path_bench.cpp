@@ -0,0 +1,252 @@
+// Hot-path benchmarks for the event and order pipeline, built on Google
+// Benchmark as the hot_path_bench CMake target.
+//
+// Every benchmark runs a fixed synthetic workload so numbers are comparable
+// between builds. For regression tracking emit JSON with
+//
+//   hot_path_bench --benchmark_out=hot_path.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/events.hpp"
+#include "gts/market_data_bus.hpp"
+#include "gts/position_engine.hpp"
+#include "gts/spot_limit.hpp"
+#include "gts/throttle.hpp"
+
+namespace {
+
+constexpr std::size_t kTickCount = 4096;
+
+// Synthetic quotes cycling through eight pairs with small price moves.
+const std::vector<gts::Event>& ticks() {
+    static const std::vector<gts::Event> events = [] {
+        std::vector<gts::Event> v(kTickCount);
+        for (std::size_t i = 0; i < kTickCount; ++i) {
+            const double move = static_cast<double>(i % 17) * 1e-5;
+            v[i] = gts::Event{static_cast<gts::Timestamp>(i), static_cast<gts::PairId>(i % 8),
+                              1.1000 + move, 1'000'000, 1.1002 + move, 1'000'000};
+        }
+        return v;
+    }();
+    return events;
+}
+
+class NullObserver : public gts::OrderStateObserver {
+public:
+    void onAck(gts::OrderId) override {}
+    void onFill(gts::OrderId, gts::Price, gts::Size) override {}
+    void onTerminated(gts::OrderId) override {}
+};
+
+// Venue stand-in that only hands out IDs and keeps the last observer so
+// callbacks can be driven explicitly.
+class NullSender : public gts::OrderSender {
+public:
+    gts::OrderId sendOrder(gts::PairId, gts::Side, gts::Price, gts::Size, gts::Tif,
+                           gts::OrderStateObserver& observer) override {
+        observer_ = &observer;
+        return next_++;
+    }
+
+    gts::OrderStateObserver* observer_ = nullptr;
+    gts::OrderId next_ = 1;
+};
+
+class SummingStrategy : public gts::Strategy {
+public:
+    void postEvent(const gts::Event& event) override { sum_ += event.bidPrice; }
+    double sum_ = 0;
+};
+
+void BM_PostEventDispatch(benchmark::State& state) {
+    const auto& events = ticks();
+    auto concrete = std::make_unique<SummingStrategy>();
+    gts::Strategy* strategy = concrete.get();
+    benchmark::DoNotOptimize(strategy);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        strategy->postEvent(events[i++ & (kTickCount - 1)]);
+    }
+    benchmark::DoNotOptimize(concrete->sum_);
+}
+BENCHMARK(BM_PostEventDispatch);
+
+// Mixed feed of quotes, trades and heartbeats dispatched through std::visit.
+void BM_FeedEventDispatch(benchmark::State& state) {
+    std::vector<gts::FeedEvent> feed;
+    for (std::size_t i = 0; i < kTickCount; ++i) {
+        switch (i % 4) {
+            case 0: feed.emplace_back(gts::Trade{0, 0, gts::Side::Buy, 1.1001, 1000}); break;
+            case 1: feed.emplace_back(gts::Heartbeat{0}); break;
+            default: feed.emplace_back(ticks()[i]); break;
+        }
+    }
+    SummingStrategy strategy;
+    double traded = 0;
+    const gts::Overloaded visitor{
+        [&](const gts::Event& quote) { strategy.postEvent(quote); },
+        [&](const gts::Trade& trade) { traded += trade.price; },
+        [](const auto&) {},
+    };
+    std::size_t i = 0;
+    for (auto _ : state) {
+        std::visit(visitor, feed[i++ & (kTickCount - 1)]);
+    }
+    benchmark::DoNotOptimize(traded);
+    benchmark::DoNotOptimize(strategy.sum_);
+}
+BENCHMARK(BM_FeedEventDispatch);
+
+void BM_PostEventMarkToMarket(benchmark::State& state) {
+    const auto& events = ticks();
+    auto engine = std::make_unique<gts::PositionEngine>();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        engine->onEvent(events[i++ & (kTickCount - 1)]);
+    }
+}
+BENCHMARK(BM_PostEventMarkToMarket);
+
+void BM_NowNanos(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gts::nowNanos());
+    }
+}
+BENCHMARK(BM_NowNanos);
+
+void BM_SendOrder(benchmark::State& state) {
+    NullSender venue;
+    NullObserver observer;
+    gts::OrderSender* sender = &venue;
+    benchmark::DoNotOptimize(sender);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            sender->sendOrder(0, gts::Side::Buy, 1.1, 1000, gts::Tif::IOC, observer));
+    }
+}
+BENCHMARK(BM_SendOrder);
+
+// sendOrder through throttle, spot limit sizer and position tracker, with the
+// order terminated straight away so the order tables stay small.
+void BM_SendOrderRiskChain(benchmark::State& state) {
+    NullSender venue;
+    NullObserver observer;
+    auto engine = std::make_unique<gts::PositionEngine>();
+    auto tracker = std::make_unique<gts::PositionTracker>(venue, *engine);
+    auto sizer = std::make_unique<gts::SpotLimitSizer>(*tracker, gts::kTotalSpotLimit,
+                                                       gts::SizingMode::Filled);
+    gts::Throttle throttle(1'000'000'000, 1'000'000'000);
+    gts::ThrottledOrderSender sender(*sizer, throttle);
+    for (auto _ : state) {
+        const gts::OrderId id =
+            sender.sendOrder(0, gts::Side::Buy, 1.1, 1000, gts::Tif::IOC, observer);
+        venue.observer_->onTerminated(id);
+    }
+}
+BENCHMARK(BM_SendOrderRiskChain);
+
+// A full order lifecycle through PositionTracker: sendOrder plus the given
+// callbacks. BM_ObserverCallback below times each callback on its own.
+template <int Callbacks>
+void BM_ObserverCallbacks(benchmark::State& state) {
+    NullSender venue;
+    NullObserver observer;
+    auto engine = std::make_unique<gts::PositionEngine>();
+    auto tracker = std::make_unique<gts::PositionTracker>(venue, *engine);
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        const gts::OrderId id = tracker->sendOrder(
+            0, ++n & 1 ? gts::Side::Buy : gts::Side::Sell, 1.1, 1000, gts::Tif::IOC, observer);
+        if (Callbacks > 0) venue.observer_->onAck(id);
+        if (Callbacks > 1) venue.observer_->onFill(id, 1.1, 1000);
+        venue.observer_->onTerminated(id);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ObserverCallbacks, 0)->Name("BM_ObserverCallbacks/terminated");
+BENCHMARK_TEMPLATE(BM_ObserverCallbacks, 1)->Name("BM_ObserverCallbacks/ack_terminated");
+BENCHMARK_TEMPLATE(BM_ObserverCallbacks, 2)->Name("BM_ObserverCallbacks/ack_fill_terminated");
+
+enum class Callback { Ack, Fill, Terminated };
+
+// One callback kind through PositionTracker. Each iteration sends a batch of
+// orders and brings them to the state the callback expects with the timer
+// paused, then times only that callback for every order in the batch; the
+// items/s counter is callbacks per second.
+template <Callback Timed>
+void BM_ObserverCallback(benchmark::State& state) {
+    constexpr std::size_t kBatch = 1024;
+    NullSender venue;
+    NullObserver observer;
+    auto engine = std::make_unique<gts::PositionEngine>();
+    auto tracker = std::make_unique<gts::PositionTracker>(venue, *engine);
+    std::vector<gts::OrderId> ids(kBatch);
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (gts::OrderId& id : ids) {
+            id = tracker->sendOrder(0, ++n & 1 ? gts::Side::Buy : gts::Side::Sell, 1.1, 1000,
+                                    gts::Tif::GTC, observer);
+            if (Timed != Callback::Ack) venue.observer_->onAck(id);
+        }
+        state.ResumeTiming();
+        for (const gts::OrderId id : ids) {
+            if (Timed == Callback::Ack) venue.observer_->onAck(id);
+            if (Timed == Callback::Fill) venue.observer_->onFill(id, 1.1, 1000);
+            if (Timed == Callback::Terminated) venue.observer_->onTerminated(id);
+        }
+        state.PauseTiming();
+        if (Timed != Callback::Terminated) {
+            for (const gts::OrderId id : ids) venue.observer_->onTerminated(id);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatch));
+}
+BENCHMARK_TEMPLATE(BM_ObserverCallback, Callback::Ack)->Name("BM_ObserverCallback/ack");
+BENCHMARK_TEMPLATE(BM_ObserverCallback, Callback::Fill)->Name("BM_ObserverCallback/fill");
+BENCHMARK_TEMPLATE(BM_ObserverCallback, Callback::Terminated)->Name("BM_ObserverCallback/terminated");
+
+void BM_MaxOrderSize(benchmark::State& state) {
+    NullSender venue;
+    auto sizer = std::make_unique<gts::SpotLimitSizer>(venue);
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        ++n;
+        benchmark::DoNotOptimize(sizer->maxOrderSize(static_cast<gts::PairId>(n & 7),
+                                                     n & 8 ? gts::Side::Buy : gts::Side::Sell));
+    }
+}
+BENCHMARK(BM_MaxOrderSize);
+
+void BM_ThrottleCanSend(benchmark::State& state) {
+    gts::Throttle throttle(1000, 100, 10, 0);
+    gts::Timestamp now = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(throttle.canSend(gts::MessageKind::New, ++now));
+    }
+}
+BENCHMARK(BM_ThrottleCanSend);
+
+// Tick decoding on the shared-memory feed: publish one event, poll it back.
+void BM_MarketDataBusDecode(benchmark::State& state) {
+    const auto& events = ticks();
+    gts::MarketDataPublisher publisher("/gts_hot_path_bench", kTickCount);
+    gts::MarketDataSubscriber subscriber("/gts_hot_path_bench");
+    gts::FeedEvent event;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        publisher.publish(events[i++ & (kTickCount - 1)]);
+        benchmark::DoNotOptimize(subscriber.poll(event));
+    }
+}
+BENCHMARK(BM_MarketDataBusDecode);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gts {
+
+// Nanoseconds since the Unix epoch.
+using Timestamp = std::int64_t;
+using OrderId = std::uint64_t;
+using PairId = std::uint16_t;
+using Price = double;
+using Size = std::int64_t;
+
+// Constant limit of total spot across every pair.
+constexpr Size kTotalSpotLimit = 10'000'000;
+constexpr PairId kMaxPairs = 64;
+
+// Returned instead of an order ID when a local pre-send check refuses the
+// order; no callbacks follow.
+constexpr OrderId kInvalidOrderId = 0;
+
+enum class Side : std::uint8_t { Buy, Sell };
+
+// GTC: good till cancel, IOC: immediate or cancel.
+enum class Tif : std::uint8_t { GTC, IOC };
+
+// Top of book update for a CCY1/CCY2 pair. askPrice/askSize is the price we
+// buy at, bidPrice/bidSize the price we sell at.
+struct Event {
+    Timestamp timestamp;
+    PairId pair;
+    Price bidPrice;
+    Size bidSize;
+    Price askPrice;
+    Size askSize;
+};
+
+// Receives updates for orders sent through an OrderSender.
+class OrderStateObserver {
+public:
+    virtual ~OrderStateObserver() = default;
+
+    virtual void onAck(OrderId id) = 0;
+    virtual void onFill(OrderId id, Price price, Size size) = 0;
+    virtual void onTerminated(OrderId id) = 0;
+};
+
+// Interface for sending orders.
+class OrderSender {
+public:
+    virtual ~OrderSender() = default;
+
+    // Sends an order and returns its order ID. Updates are delivered to
+    // |observer| until onTerminated.
+    virtual OrderId sendOrder(PairId pair, Side side, Price price, Size size,
+                              Tif tif, OrderStateObserver& observer) = 0;
+};
+
+// Interface for implementing a strategy.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    virtual void postEvent(const Event& event) = 0;
+};
+
+}  // namespace gts
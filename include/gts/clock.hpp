@@ -0,0 +1,21 @@
+#pragma once
+
+#include "gts/api.hpp"
+#include "gts/tsc_clock.hpp"
+
+namespace gts {
+
+// Wall clock in nanoseconds, the same time base as Event::timestamp. Every
+// local stamp (postEvent() arrival, sendOrder() departure, logs, traces) goes
+// through here so they can be compared directly.
+inline Timestamp nowNanos() noexcept {
+    return TscClock::instance().now();
+}
+
+// Calibrates the clock up front. Otherwise the first nowNanos() call pays
+// the 20 ms calibration, typically on the hot path.
+inline void initClock() {
+    TscClock::instance();
+}
+
+}  // namespace gts
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+using CurrencyId = std::uint8_t;
+
+constexpr PairId kNoPair = static_cast<PairId>(~PairId{0});
+
+// Implied CCY1/CCY2 quote built from two legs through a common currency.
+struct CrossRate {
+    CurrencyId ccy1;
+    CurrencyId ccy2;
+    CurrencyId via;
+    // The directly quoted pair for ccy1/ccy2, kNoPair when there is none.
+    PairId direct;
+    Price bid;
+    Price ask;
+    Timestamp updated;
+};
+
+// Currency graph over the traded pairs. Every triangle reachable through two
+// quoted legs gets an implied cross, and each pair keeps the list of crosses
+// that depend on it, so a tick only recomputes the crosses it affects.
+// Setup (addPair) is cold; onEvent() does no allocation or lookups.
+class CrossRateEngine {
+public:
+    static constexpr std::size_t kMaxCurrencies = 32;
+    static constexpr std::size_t kMaxCrosses = 512;
+    static constexpr std::size_t kMaxDependents = 32;
+
+    // Registers |pair| as quoting |ccy1|/|ccy2|, e.g. "EUR", "USD", and adds
+    // every cross it completes with already registered pairs. Registering a
+    // pair again with the same currencies does nothing; with different ones
+    // it throws.
+    void addPair(PairId pair, const char* ccy1, const char* ccy2) {
+        if (pair >= kMaxPairs) {
+            throw std::out_of_range("CrossRateEngine: pair ID out of range");
+        }
+        const CurrencyId a = currency(ccy1);
+        const CurrencyId b = currency(ccy2);
+        if (quotes_[pair].registered) {
+            if (quotes_[pair].ccy1 != a || quotes_[pair].ccy2 != b) {
+                throw std::invalid_argument("CrossRateEngine: pair already quotes other currencies");
+            }
+            return;
+        }
+        quotes_[pair] = Quote{a, b, 0, 0, 0, true};
+
+        for (PairId other = 0; other < kMaxPairs; ++other) {
+            const Quote& q = quotes_[other];
+            if (other == pair || !q.registered) {
+                continue;
+            }
+            // Through a common currency, pair and other imply the cross
+            // between their remaining currencies, in both orientations.
+            if (q.ccy1 == b && q.ccy2 != a) addCrosses(a, b, q.ccy2, pair, other);
+            if (q.ccy2 == b && q.ccy1 != a) addCrosses(a, b, q.ccy1, pair, other);
+            if (q.ccy1 == a && q.ccy2 != b) addCrosses(b, a, q.ccy2, pair, other);
+            if (q.ccy2 == a && q.ccy1 != b) addCrosses(b, a, q.ccy1, pair, other);
+        }
+        // A new pair may be the direct quote for existing crosses.
+        for (std::size_t i = 0; i < crossCount_; ++i) {
+            if (crosses_[i].rate.ccy1 == a && crosses_[i].rate.ccy2 == b) {
+                crosses_[i].rate.direct = pair;
+            }
+        }
+    }
+
+    // Updates the leg quote and recomputes only the dependent crosses.
+    // |onCross| is called with the index of every recomputed cross.
+    template <typename F>
+    void onEvent(const Event& event, F&& onCross) {
+        Quote& q = quotes_[event.pair];
+        q.bid = event.bidPrice;
+        q.ask = event.askPrice;
+        q.updated = event.timestamp;
+        const Dependents& deps = dependents_[event.pair];
+        for (std::uint8_t i = 0; i < deps.count; ++i) {
+            const std::uint16_t index = deps.crosses[i];
+            if (recompute(index)) {
+                onCross(index);
+            }
+        }
+    }
+
+    void onEvent(const Event& event) {
+        onEvent(event, [](std::uint16_t) {});
+    }
+
+    const CrossRate& cross(std::size_t index) const noexcept { return crosses_[index].rate; }
+    std::size_t crossCount() const noexcept { return crossCount_; }
+
+    // Index of the first cross for ccy1/ccy2, or -1.
+    int findCross(const char* ccy1, const char* ccy2) const noexcept {
+        const int a = findCurrency(ccy1);
+        const int b = findCurrency(ccy2);
+        for (std::size_t i = 0; i < crossCount_; ++i) {
+            if (crosses_[i].rate.ccy1 == a && crosses_[i].rate.ccy2 == b) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+private:
+    struct Quote {
+        CurrencyId ccy1;
+        CurrencyId ccy2;
+        Price bid;
+        Price ask;
+        Timestamp updated;
+        bool registered;
+    };
+
+    // A leg converts from one currency to the next; inverted legs trade the
+    // quoted pair the other way round.
+    struct Leg {
+        PairId pair;
+        bool inverted;
+    };
+
+    struct Cross {
+        CrossRate rate;
+        Leg first;
+        Leg second;
+    };
+
+    struct Dependents {
+        std::array<std::uint16_t, kMaxDependents> crosses;
+        std::uint8_t count;
+    };
+
+    CurrencyId currency(const char* code) {
+        const int found = findCurrency(code);
+        if (found >= 0) {
+            return static_cast<CurrencyId>(found);
+        }
+        if (currencyCount_ == kMaxCurrencies) {
+            throw std::length_error("CrossRateEngine: too many currencies");
+        }
+        // Codes are stored without a terminator; shorter ones are zero padded.
+        char* stored = currencies_[currencyCount_];
+        for (std::size_t i = 0; i < 3 && code[i] != '\0'; ++i) {
+            stored[i] = code[i];
+        }
+        return static_cast<CurrencyId>(currencyCount_++);
+    }
+
+    int findCurrency(const char* code) const noexcept {
+        for (std::size_t i = 0; i < currencyCount_; ++i) {
+            if (std::strncmp(currencies_[i], code, 3) == 0) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    Leg leg(PairId pair, CurrencyId from) const noexcept {
+        return Leg{pair, quotes_[pair].ccy1 != from};
+    }
+
+    // |ab| quotes a and b, |bc| quotes b and c: adds the implied a/c and c/a
+    // crosses through b.
+    void addCrosses(CurrencyId a, CurrencyId b, CurrencyId c, PairId ab, PairId bc) {
+        addCross(a, c, b, leg(ab, a), leg(bc, b));
+        addCross(c, a, b, leg(bc, c), leg(ab, b));
+    }
+
+    void addCross(CurrencyId from, CurrencyId to, CurrencyId via, Leg first, Leg second) {
+        if (crossCount_ == kMaxCrosses) {
+            throw std::length_error("CrossRateEngine: too many crosses");
+        }
+        const auto index = static_cast<std::uint16_t>(crossCount_++);
+        Cross& c = crosses_[index];
+        c.rate = CrossRate{from, to, via, kNoPair, 0, 0, 0};
+        c.first = first;
+        c.second = second;
+        for (PairId p = 0; p < kMaxPairs; ++p) {
+            const Quote& q = quotes_[p];
+            if (q.registered && q.ccy1 == from && q.ccy2 == to) {
+                c.rate.direct = p;
+            }
+        }
+        addDependent(first.pair, index);
+        addDependent(second.pair, index);
+    }
+
+    void addDependent(PairId pair, std::uint16_t index) {
+        Dependents& deps = dependents_[pair];
+        if (deps.count == kMaxDependents) {
+            throw std::length_error("CrossRateEngine: too many crosses per pair");
+        }
+        deps.crosses[deps.count++] = index;
+    }
+
+    // Selling ccy1 for ccy2 through the legs gives the bid, buying gives the
+    // ask. Returns false while either leg has no quote yet.
+    bool recompute(std::uint16_t index) noexcept {
+        Cross& c = crosses_[index];
+        const Quote& q1 = quotes_[c.first.pair];
+        const Quote& q2 = quotes_[c.second.pair];
+        if (q1.bid <= 0 || q1.ask <= 0 || q2.bid <= 0 || q2.ask <= 0) {
+            return false;
+        }
+        const Price bid1 = c.first.inverted ? 1 / q1.ask : q1.bid;
+        const Price ask1 = c.first.inverted ? 1 / q1.bid : q1.ask;
+        const Price bid2 = c.second.inverted ? 1 / q2.ask : q2.bid;
+        const Price ask2 = c.second.inverted ? 1 / q2.bid : q2.ask;
+        c.rate.bid = bid1 * bid2;
+        c.rate.ask = ask1 * ask2;
+        c.rate.updated = q1.updated > q2.updated ? q1.updated : q2.updated;
+        return true;
+    }
+
+    std::array<Quote, kMaxPairs> quotes_{};
+    std::array<Dependents, kMaxPairs> dependents_{};
+    std::array<Cross, kMaxCrosses> crosses_{};
+    std::size_t crossCount_ = 0;
+    char currencies_[kMaxCurrencies][3] = {};
+    std::size_t currencyCount_ = 0;
+};
+
+}  // namespace gts
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+// Per-strategy monotonic arena for temporaries built while reacting to a
+// tick. Standard containers use it through resource(), e.g.
+// std::pmr::vector<Price> levels(arena.resource()). Everything allocated is
+// released at once by reset(), which ArenaScopedStrategy calls after every
+// postEvent(). Allocations beyond the preallocated block fall back to the
+// heap and are counted so the block can be sized from real sessions.
+class EventArena {
+public:
+    explicit EventArena(std::size_t bytes = 256 * 1024)
+        : buffer_(new std::byte[bytes]),
+          size_(bytes),
+          monotonic_(buffer_.get(), size_, &overflow_) {}
+
+    EventArena(const EventArena&) = delete;
+    EventArena& operator=(const EventArena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &monotonic_; }
+
+    void reset() noexcept { monotonic_.release(); }
+
+    std::size_t capacity() const noexcept { return size_; }
+
+    // Allocations that did not fit the preallocated block.
+    std::uint64_t overflows() const noexcept { return overflow_.count; }
+
+private:
+    // Heap upstream that counts how often the arena outgrows its block.
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        std::uint64_t count = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++count;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t size_;
+    OverflowResource overflow_;
+    std::pmr::monotonic_buffer_resource monotonic_;
+};
+
+// Strategy decorator that resets |arena| once postEvent() returns, so any
+// pmr container the strategy built from it during the tick is gone.
+class ArenaScopedStrategy : public Strategy {
+public:
+    ArenaScopedStrategy(Strategy& inner, EventArena& arena) : inner_(inner), arena_(arena) {}
+
+    void postEvent(const Event& event) override {
+        inner_.postEvent(event);
+        arena_.reset();
+    }
+
+private:
+    Strategy& inner_;
+    EventArena& arena_;
+};
+
+}  // namespace gts
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <type_traits>
+#include <variant>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+enum class SessionState : std::uint8_t { PreOpen, Open, Halted, Closed };
+
+struct Trade {
+    Timestamp timestamp;
+    PairId pair;
+    Side aggressor;
+    Price price;
+    Size size;
+};
+
+// One L2 price level; size 0 removes the level. Side::Buy is the bid side.
+struct DepthUpdate {
+    Timestamp timestamp;
+    PairId pair;
+    Side side;
+    Price price;
+    Size size;
+};
+
+struct SessionStatus {
+    Timestamp timestamp;
+    SessionState state;
+};
+
+struct Heartbeat {
+    Timestamp timestamp;
+};
+
+// Everything the feed can deliver, as a closed fixed-size variant. Events are
+// passed by value through rings and dispatched with std::visit, which
+// compiles to a jump table: no allocation and no virtual call per event.
+// Quote updates are the API's Event. The active index travels through shared
+// memory and tick files, so new alternatives go at the end.
+using FeedEvent = std::variant<Event, Trade, SessionStatus, Heartbeat, DepthUpdate>;
+
+static_assert(std::is_trivially_copyable_v<FeedEvent>,
+              "FeedEvent must stay trivially copyable to travel through rings and shared memory");
+
+// Builds a visitor from a set of lambdas.
+template <typename... Fs>
+struct Overloaded : Fs... {
+    using Fs::operator()...;
+};
+template <typename... Fs>
+Overloaded(Fs...) -> Overloaded<Fs...>;
+
+inline Timestamp timestampOf(const FeedEvent& event) noexcept {
+    return std::visit([](const auto& e) { return e.timestamp; }, event);
+}
+
+// Quote updates go to Strategy::postEvent(); other events are ignored.
+inline void deliver(Strategy& strategy, const FeedEvent& event) {
+    if (const Event* quote = std::get_if<Event>(&event)) {
+        strategy.postEvent(*quote);
+    }
+}
+
+}  // namespace gts
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "gts/api.hpp"
+#include "gts/events.hpp"
+#include "gts/fixed_point.hpp"
+
+namespace gts {
+
+// Per-pair signals in Fixed units. imbalance is in [-1, 1] and tradeFlow is
+// an EWMA of signed traded size (positive when buyers aggress).
+struct FairValue {
+    Timestamp updated;
+    Fixed mid;
+    Fixed microprice;
+    Fixed imbalance;
+    // Microprice minus its slow EWMA: positive when it is trending up.
+    Fixed drift;
+    Fixed lastTrade;
+    Size tradeFlow;
+};
+
+// Incremental fair value from top of book and trades. Everything is integer
+// arithmetic with 128-bit intermediates and power-of-two EWMA weights, so an
+// update is O(1), never divides by a small float and never accumulates
+// rounding drift.
+class FairValueEngine {
+public:
+    // EWMA weights are 2^-shift per update; larger is slower.
+    explicit FairValueEngine(unsigned driftShift = 6, unsigned flowShift = 4)
+        : driftShift_(driftShift), flowShift_(flowShift) {}
+
+    void onEvent(const Event& event) noexcept {
+        State& s = pairs_[event.pair];
+        FairValue& v = s.value;
+        const Fixed bid = toFixed(event.bidPrice);
+        const Fixed ask = toFixed(event.askPrice);
+        const Size depth = event.bidSize + event.askSize;
+        v.updated = event.timestamp;
+        v.mid = bid + (ask - bid) / 2;
+        if (depth > 0) {
+            // Weighted towards the side with less size: it is about to move.
+            v.microprice = static_cast<Fixed>(
+                (static_cast<__int128>(bid) * event.askSize +
+                 static_cast<__int128>(ask) * event.bidSize) / depth);
+            v.imbalance = mulDiv(event.bidSize - event.askSize, kFixedScale, depth);
+        } else {
+            v.microprice = v.mid;
+            v.imbalance = 0;
+        }
+        if (!s.seeded) {
+            s.slow = v.microprice;
+            s.seeded = true;
+        }
+        s.slow += (v.microprice - s.slow) / (Fixed{1} << driftShift_);
+        v.drift = v.microprice - s.slow;
+    }
+
+    void onTrade(PairId pair, Side aggressor, Price price, Size size) noexcept {
+        FairValue& v = pairs_[pair].value;
+        v.lastTrade = toFixed(price);
+        const Size signedSize = aggressor == Side::Buy ? size : -size;
+        v.tradeFlow += (signedSize - v.tradeFlow) / (Size{1} << flowShift_);
+    }
+
+    void onTrade(const Trade& trade) noexcept {
+        onTrade(trade.pair, trade.aggressor, trade.price, trade.size);
+    }
+
+    // Our own fills, with |side| and |tif| those of our order. An IOC took
+    // liquidity, so we aggressed; a GTC is taken as resting, so the other
+    // side aggressed into it.
+    void onFill(PairId pair, Side side, Tif tif, Price price, Size size) noexcept {
+        const Side aggressor = tif == Tif::IOC ? side : opposite(side);
+        onTrade(pair, aggressor, price, size);
+    }
+
+    const FairValue& value(PairId pair) const noexcept { return pairs_[pair].value; }
+
+private:
+    static Side opposite(Side side) noexcept { return side == Side::Buy ? Side::Sell : Side::Buy; }
+
+    struct State {
+        FairValue value;
+        Fixed slow;
+        bool seeded;
+    };
+
+    unsigned driftShift_;
+    unsigned flowShift_;
+    std::array<State, kMaxPairs> pairs_{};
+};
+
+}  // namespace gts
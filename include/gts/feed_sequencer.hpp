@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_restore.hpp"
+
+namespace gts {
+
+// Sequence tracking on the feed path. In-sequence ticks go straight to the
+// strategy. A sequence jump marks every pair stale, asks for a snapshot and
+// buffers later deltas; once the snapshot is applied the buffered deltas
+// newer than it are replayed and the feed is live again. A snapshot that
+// does not arrive within the resync timeout is requested again, and after
+// kMaxSnapshotRequests the sequencer gives up and goes live from the buffered
+// deltas; each tick is a full top-of-book quote, so a pair is current again
+// from its next quote. Without a SnapshotRequest there is nothing to wait for
+// and a gap only marks every pair stale. A quiet socket also marks every pair
+// stale. checkTimeouts() drives both timers.
+//
+// Staleness is a generation compare: each pair remembers the generation it
+// was last refreshed in, and invalidating all pairs is one increment.
+class FeedSequencer {
+public:
+    // Asked to send a snapshot; |nextExpected| is the first missing sequence.
+    using SnapshotRequest = std::function<void(std::uint64_t nextExpected)>;
+
+    static constexpr std::size_t kBufferCapacity = 1 << 14;
+    static constexpr unsigned kMaxSnapshotRequests = 3;
+
+    explicit FeedSequencer(Strategy& strategy, SnapshotRequest requestSnapshot = {},
+                           Timestamp stallTimeout = 50'000'000,
+                           Timestamp resyncTimeout = 200'000'000)
+        : strategy_(strategy),
+          requestSnapshot_(std::move(requestSnapshot)),
+          stallTimeout_(stallTimeout),
+          resyncTimeout_(resyncTimeout),
+          buffer_(new Buffered[kBufferCapacity]) {}
+
+    // |receivedAt| is the local receive time, not the venue timestamp, so the
+    // stall check is not skewed by venue clock offset or feed latency.
+    void onTick(std::uint64_t sequence, const Event& event, Timestamp receivedAt = nowNanos()) {
+        lastMessage_ = receivedAt;
+        stalled_ = false;
+        if (resyncing_) {
+            buffer(sequence, event);
+            return;
+        }
+        if (sequence < expected_) {
+            ++duplicates_;
+            return;
+        }
+        if (sequence > expected_ && started_) {
+            ++gaps_;
+            if (!requestSnapshot_) {
+                // No snapshot source: pairs are stale until their next quote.
+                ++generation_;
+            } else {
+                beginResync(receivedAt);
+                buffer(sequence, event);
+                return;
+            }
+        }
+        started_ = true;
+        expected_ = sequence + 1;
+        apply(event);
+    }
+
+    // One pair's quote from the requested snapshot. Snapshot messages that
+    // arrive when no resync is in progress, e.g. a late answer to a request
+    // that was abandoned, are older than the live feed and are ignored.
+    void onSnapshot(const Event& event) {
+        if (resyncing_) {
+            apply(event);
+        }
+    }
+
+    // The snapshot reflects every delta up to and including |lastSequence|.
+    void onSnapshotComplete(std::uint64_t lastSequence) {
+        if (!resyncing_) {
+            return;
+        }
+        if (overflowed_) {
+            // Deltas were lost while waiting; the snapshot alone is not enough.
+            beginResync(nowNanos());
+            return;
+        }
+        expected_ = lastSequence + 1;
+        for (std::size_t i = 0; i < buffered_; ++i) {
+            const Buffered& b = buffer_[i];
+            if (b.sequence == expected_) {
+                ++expected_;
+                apply(b.event);
+            } else if (b.sequence > expected_) {
+                // Still a hole after the snapshot: try again from there.
+                ++gaps_;
+                beginResync(nowNanos());
+                return;
+            }
+        }
+        buffered_ = 0;
+        resyncing_ = false;
+    }
+
+    // Call periodically with nowNanos(). Marks every pair stale if nothing has
+    // arrived for the stall timeout, and retries or abandons a resync whose
+    // snapshot is overdue.
+    void checkTimeouts(Timestamp now) {
+        if (!stalled_ && lastMessage_ != 0 && now - lastMessage_ > stallTimeout_) {
+            stalled_ = true;
+            ++stalls_;
+            ++generation_;
+        }
+        if (resyncing_ && now - resyncStarted_ > resyncTimeout_) {
+            if (snapshotRequests_ < kMaxSnapshotRequests) {
+                ++snapshotRequests_;
+                resyncStarted_ = now;
+                requestSnapshot_(expected_);
+            } else {
+                ++abandonedResyncs_;
+                resume();
+            }
+        }
+    }
+
+    bool isFresh(PairId pair) const noexcept { return pairGeneration_[pair] == generation_; }
+
+    bool resyncing() const noexcept { return resyncing_; }
+    std::uint64_t gaps() const noexcept { return gaps_; }
+    std::uint64_t stalls() const noexcept { return stalls_; }
+    std::uint64_t duplicates() const noexcept { return duplicates_; }
+    std::uint64_t abandonedResyncs() const noexcept { return abandonedResyncs_; }
+
+private:
+    struct Buffered {
+        std::uint64_t sequence;
+        Event event;
+    };
+
+    void apply(const Event& event) {
+        pairGeneration_[event.pair] = generation_;
+        strategy_.postEvent(event);
+    }
+
+    void beginResync(Timestamp now) {
+        ++generation_;
+        resyncing_ = true;
+        overflowed_ = false;
+        buffered_ = 0;
+        resyncStarted_ = now;
+        snapshotRequests_ = 1;
+        requestSnapshot_(expected_);
+    }
+
+    // Goes live without a snapshot, accepting the hole. If the buffer
+    // overflowed, its quotes may be older than ones that were dropped, so
+    // pairs are left stale until their next live quote instead.
+    void resume() {
+        if (overflowed_) {
+            ++generation_;
+        } else {
+            for (std::size_t i = 0; i < buffered_; ++i) {
+                const Buffered& b = buffer_[i];
+                if (b.sequence >= expected_) {
+                    expected_ = b.sequence + 1;
+                    apply(b.event);
+                }
+            }
+        }
+        buffered_ = 0;
+        resyncing_ = false;
+        overflowed_ = false;
+    }
+
+    void buffer(std::uint64_t sequence, const Event& event) noexcept {
+        if (buffered_ == kBufferCapacity) {
+            overflowed_ = true;
+            return;
+        }
+        buffer_[buffered_++] = Buffered{sequence, event};
+    }
+
+    Strategy& strategy_;
+    SnapshotRequest requestSnapshot_;
+    Timestamp stallTimeout_;
+    Timestamp resyncTimeout_;
+    std::unique_ptr<Buffered[]> buffer_;
+    std::size_t buffered_ = 0;
+    std::uint64_t expected_ = 0;
+    // Pairs start stale: generation 1 until their first quote.
+    std::uint64_t generation_ = 1;
+    std::array<std::uint64_t, kMaxPairs> pairGeneration_{};
+    Timestamp lastMessage_ = 0;
+    Timestamp resyncStarted_ = 0;
+    unsigned snapshotRequests_ = 0;
+    bool started_ = false;
+    bool resyncing_ = false;
+    bool overflowed_ = false;
+    bool stalled_ = false;
+    std::uint64_t gaps_ = 0;
+    std::uint64_t stalls_ = 0;
+    std::uint64_t duplicates_ = 0;
+    std::uint64_t abandonedResyncs_ = 0;
+};
+
+// OrderSender decorator that refuses orders on pairs the sequencer considers
+// stale, returning kInvalidOrderId.
+class FreshOrderSender : public ForwardingRestorableSender {
+public:
+    FreshOrderSender(OrderSender& inner, const FeedSequencer& sequencer)
+        : ForwardingRestorableSender(inner), sequencer_(sequencer) {}
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        if (!sequencer_.isFresh(pair)) {
+            return kInvalidOrderId;
+        }
+        return inner_.sendOrder(pair, side, price, size, tif, observer);
+    }
+
+private:
+    const FeedSequencer& sequencer_;
+};
+
+}  // namespace gts
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+// Prices and CCY2 amounts in fixed point with eight decimals. A full spot
+// limit at a JPY-sized price still fits in 64 bits; products of two fixed
+// values go through 128-bit intermediates.
+using Fixed = std::int64_t;
+constexpr Fixed kFixedScale = 100'000'000;
+
+inline Fixed toFixed(Price price) noexcept {
+    return static_cast<Fixed>(std::llround(price * static_cast<double>(kFixedScale)));
+}
+
+inline Price fromFixed(Fixed value) noexcept {
+    return static_cast<Price>(value) / static_cast<Price>(kFixedScale);
+}
+
+// a * b / c without intermediate overflow.
+inline Fixed mulDiv(std::int64_t a, std::int64_t b, std::int64_t c) noexcept {
+    return static_cast<Fixed>(static_cast<__int128>(a) * b / c);
+}
+
+}  // namespace gts
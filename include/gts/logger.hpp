@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/spsc_ring.hpp"
+#include "gts/thread_rings.hpp"
+
+namespace gts {
+
+enum class LogLevel : std::uint8_t { Debug, Info, Warn, Error };
+
+// Deferred log line: the format string pointer plus raw argument values.
+// Formatting happens on the logger thread, so the format string and any
+// const char* arguments must outlive the call (string literals in practice).
+struct LogEntry {
+    enum class ArgType : std::uint8_t { Int, UInt, Double, Char, Str };
+
+    union Arg {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        char c;
+        const char* s;
+    };
+
+    static constexpr std::size_t kMaxArgs = 8;
+
+    Timestamp timestamp;
+    const char* format;
+    Arg args[kMaxArgs];
+    ArgType types[kMaxArgs];
+    LogLevel level;
+    std::uint8_t argCount;
+};
+
+// Asynchronous logger for strategy hot paths. log() stamps the entry with
+// nowNanos() and pushes it into the calling thread's ring; a background thread
+// substitutes each "{}" in the format with the next argument and writes it out.
+class Logger {
+public:
+    static constexpr std::size_t kRingCapacity = 1 << 14;
+
+    explicit Logger(std::FILE* out = stderr, LogLevel minLevel = LogLevel::Info)
+        : out_(out), ownsFile_(false), minLevel_(minLevel) {
+        start();
+    }
+
+    explicit Logger(const std::string& path, LogLevel minLevel = LogLevel::Info)
+        : out_(std::fopen(path.c_str(), "w")), ownsFile_(true), minLevel_(minLevel) {
+        if (out_ == nullptr) {
+            throw std::runtime_error("Logger: cannot open " + path);
+        }
+        start();
+    }
+
+    ~Logger() {
+        running_.store(false, std::memory_order_release);
+        worker_.join();
+        if (ownsFile_) {
+            std::fclose(out_);
+        }
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    template <typename... Args>
+    void log(LogLevel level, const char* format, const Args&... args) noexcept {
+        static_assert(sizeof...(Args) <= LogEntry::kMaxArgs, "too many log arguments");
+        if (level < minLevel_) {
+            return;
+        }
+        LogEntry entry;
+        entry.timestamp = nowNanos();
+        entry.format = format;
+        entry.level = level;
+        entry.argCount = 0;
+        (encode(entry, args), ...);
+        if (!rings_.local().ring.tryPush(entry)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename... Args>
+    void debug(const char* format, const Args&... args) noexcept { log(LogLevel::Debug, format, args...); }
+    template <typename... Args>
+    void info(const char* format, const Args&... args) noexcept { log(LogLevel::Info, format, args...); }
+    template <typename... Args>
+    void warn(const char* format, const Args&... args) noexcept { log(LogLevel::Warn, format, args...); }
+    template <typename... Args>
+    void error(const char* format, const Args&... args) noexcept { log(LogLevel::Error, format, args...); }
+
+    std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Ring = SpscRing<LogEntry, kRingCapacity>;
+
+    template <typename T>
+    static void encode(LogEntry& entry, const T& value) noexcept {
+        LogEntry::Arg& arg = entry.args[entry.argCount];
+        LogEntry::ArgType& type = entry.types[entry.argCount];
+        if constexpr (std::is_same_v<T, char>) {
+            arg.c = value;
+            type = LogEntry::ArgType::Char;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            arg.s = value ? "true" : "false";
+            type = LogEntry::ArgType::Str;
+        } else if constexpr (std::is_enum_v<T>) {
+            arg.i = static_cast<std::int64_t>(value);
+            type = LogEntry::ArgType::Int;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.i = value;
+            type = LogEntry::ArgType::Int;
+        } else if constexpr (std::is_integral_v<T>) {
+            arg.u = value;
+            type = LogEntry::ArgType::UInt;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            arg.d = value;
+            type = LogEntry::ArgType::Double;
+        } else {
+            static_assert(std::is_convertible_v<T, const char*>,
+                          "log arguments must be arithmetic, enums or string literals");
+            arg.s = value;
+            type = LogEntry::ArgType::Str;
+        }
+        ++entry.argCount;
+    }
+
+    void start() {
+        line_.reserve(512);
+        worker_ = std::thread([this] { run(); });
+    }
+
+    void write(const LogEntry& entry) {
+        static constexpr const char* kLevelNames[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+        char scratch[64];
+        line_.clear();
+        std::snprintf(scratch, sizeof(scratch), "%" PRId64 " %-5s ", entry.timestamp,
+                      kLevelNames[static_cast<int>(entry.level)]);
+        line_ += scratch;
+        std::uint8_t next = 0;
+        for (const char* p = entry.format; *p != '\0'; ++p) {
+            if (p[0] == '{' && p[1] == '}' && next < entry.argCount) {
+                const LogEntry::Arg& arg = entry.args[next];
+                switch (entry.types[next++]) {
+                    case LogEntry::ArgType::Int:
+                        std::snprintf(scratch, sizeof(scratch), "%" PRId64, arg.i);
+                        break;
+                    case LogEntry::ArgType::UInt:
+                        std::snprintf(scratch, sizeof(scratch), "%" PRIu64, arg.u);
+                        break;
+                    case LogEntry::ArgType::Double:
+                        std::snprintf(scratch, sizeof(scratch), "%.10g", arg.d);
+                        break;
+                    case LogEntry::ArgType::Char:
+                        scratch[0] = arg.c;
+                        scratch[1] = '\0';
+                        break;
+                    case LogEntry::ArgType::Str:
+                        line_ += arg.s;
+                        scratch[0] = '\0';
+                        break;
+                }
+                line_ += scratch;
+                ++p;
+            } else {
+                line_ += *p;
+            }
+        }
+        line_ += '\n';
+        std::fwrite(line_.data(), 1, line_.size(), out_);
+    }
+
+    std::size_t drain() {
+        std::size_t count = 0;
+        rings_.forEach([&](auto& slot) {
+            LogEntry entry;
+            while (slot.ring.tryPop(entry)) {
+                write(entry);
+                ++count;
+            }
+        });
+        return count;
+    }
+
+    void run() {
+        while (running_.load(std::memory_order_acquire)) {
+            if (drain() == 0) {
+                std::fflush(out_);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        drain();
+        std::fflush(out_);
+    }
+
+    std::FILE* out_;
+    bool ownsFile_;
+    LogLevel minLevel_;
+    ThreadRings<Ring> rings_;
+    std::string line_;
+    std::atomic<bool> running_{true};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::thread worker_;
+};
+
+}  // namespace gts
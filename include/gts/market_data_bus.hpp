@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "gts/api.hpp"
+#include "gts/events.hpp"
+#include "gts/shm.hpp"
+#include "gts/spsc_ring.hpp"
+
+namespace gts {
+
+// Shared-memory broadcast ring for FeedEvents: one feed process publishes,
+// any number of strategy processes read with their own cursor. The writer
+// never waits for readers; a reader that falls a full ring behind detects
+// the overrun and skips to the oldest event still intact.
+//
+// Each slot is a sequence lock: the sequence is 2n+1 while event n is being
+// written and 2n+2 once it is complete.
+namespace bus_detail {
+
+constexpr std::uint64_t kMagic = 0x4754534D44425553ull;  // "GTSMDBUS"
+constexpr std::size_t kEventWords = (sizeof(FeedEvent) + 7) / 8;
+
+struct Header {
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t capacity;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> published;
+};
+
+struct alignas(kCacheLineSize) Slot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[kEventWords];
+};
+
+inline std::size_t mappingSize(std::uint64_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+inline Slot* slots(void* base) {
+    return reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header));
+}
+
+}  // namespace bus_detail
+
+class MarketDataPublisher {
+public:
+    MarketDataPublisher(const std::string& name, std::uint64_t capacity)
+        : shm_(SharedMemory::create(name, bus_detail::mappingSize(checked(capacity)))) {
+        header_ = new (shm_.data()) bus_detail::Header{};
+        slots_ = bus_detail::slots(shm_.data());
+        for (std::uint64_t i = 0; i < capacity; ++i) {
+            new (&slots_[i]) bus_detail::Slot{};
+        }
+        header_->capacity = capacity;
+        mask_ = capacity - 1;
+        header_->magic.store(bus_detail::kMagic, std::memory_order_release);
+    }
+
+    void publish(const FeedEvent& event) noexcept {
+        const std::uint64_t n = next_++;
+        bus_detail::Slot& slot = slots_[n & mask_];
+        std::uint64_t words[bus_detail::kEventWords] = {};
+        std::memcpy(words, &event, sizeof(FeedEvent));
+        slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < bus_detail::kEventWords; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * n + 2, std::memory_order_release);
+        header_->published.store(n + 1, std::memory_order_release);
+    }
+
+private:
+    static std::uint64_t checked(std::uint64_t capacity) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("MarketDataPublisher: capacity must be a power of two");
+        }
+        return capacity;
+    }
+
+    SharedMemory shm_;
+    bus_detail::Header* header_;
+    bus_detail::Slot* slots_;
+    std::uint64_t mask_;
+    std::uint64_t next_ = 0;
+};
+
+class MarketDataSubscriber {
+public:
+    // Attaches to a running publisher and starts from its newest event.
+    explicit MarketDataSubscriber(const std::string& name)
+        : shm_(SharedMemory::open(name)) {
+        header_ = static_cast<bus_detail::Header*>(shm_.data());
+        if (shm_.size() < sizeof(bus_detail::Header) ||
+            header_->magic.load(std::memory_order_acquire) != bus_detail::kMagic ||
+            shm_.size() < bus_detail::mappingSize(header_->capacity)) {
+            throw std::runtime_error("MarketDataSubscriber: " + name + " is not a market data bus");
+        }
+        slots_ = bus_detail::slots(shm_.data());
+        mask_ = header_->capacity - 1;
+        cursor_ = header_->published.load(std::memory_order_acquire);
+    }
+
+    // Reads the next event into |event|. Returns false when caught up.
+    bool poll(FeedEvent& event) noexcept {
+        for (;;) {
+            const bus_detail::Slot& slot = slots_[cursor_ & mask_];
+            const std::uint64_t expected = 2 * cursor_ + 2;
+            const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before < expected) {
+                return false;
+            }
+            std::uint64_t words[bus_detail::kEventWords];
+            if (before == expected) {
+                for (std::size_t i = 0; i < bus_detail::kEventWords; ++i) {
+                    words[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+                    std::memcpy(&event, words, sizeof(FeedEvent));
+                    ++cursor_;
+                    return true;
+                }
+            }
+            // Lapped by the writer: skip to the oldest event still intact.
+            const std::uint64_t published = header_->published.load(std::memory_order_acquire);
+            const std::uint64_t oldest = published > mask_ ? published - mask_ : 0;
+            overruns_ += oldest - cursor_;
+            cursor_ = oldest;
+        }
+    }
+
+    // Visits every pending event with |visitor|; returns how many.
+    template <typename Visitor>
+    std::size_t visit(Visitor&& visitor, std::size_t maxEvents = ~std::size_t{0}) {
+        FeedEvent event;
+        std::size_t count = 0;
+        while (count < maxEvents && poll(event)) {
+            std::visit(visitor, event);
+            ++count;
+        }
+        return count;
+    }
+
+    // Delivers pending quote updates to |strategy|; returns how many events
+    // were consumed.
+    std::size_t dispatch(Strategy& strategy, std::size_t maxEvents = ~std::size_t{0}) {
+        FeedEvent event;
+        std::size_t count = 0;
+        while (count < maxEvents && poll(event)) {
+            deliver(strategy, event);
+            ++count;
+        }
+        return count;
+    }
+
+    // Events lost because this reader fell more than a ring behind.
+    std::uint64_t overruns() const noexcept { return overruns_; }
+
+private:
+    SharedMemory shm_;
+    bus_detail::Header* header_;
+    bus_detail::Slot* slots_;
+    std::uint64_t mask_;
+    std::uint64_t cursor_;
+    std::uint64_t overruns_ = 0;
+};
+
+}  // namespace gts
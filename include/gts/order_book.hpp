@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "gts/api.hpp"
+#include "gts/events.hpp"
+#include "gts/fixed_point.hpp"
+
+namespace gts {
+
+struct BookLevel {
+    Fixed price;
+    Size size;
+};
+
+// Fixed-depth L2 book for one pair. Each side is a sorted array, best level
+// first; updates shift levels in place, so the whole book stays in a few
+// contiguous cache lines. Levels beyond Depth are dropped.
+template <std::size_t Depth = 16>
+class OrderBook {
+public:
+    // Sets the size at |price|; size 0 removes the level.
+    void update(Side side, Fixed price, Size size) noexcept {
+        Ladder& ladder = side == Side::Buy ? bids_ : asks_;
+        const bool bid = side == Side::Buy;
+        std::size_t i = 0;
+        while (i < ladder.count && (bid ? ladder.levels[i].price > price
+                                        : ladder.levels[i].price < price)) {
+            ++i;
+        }
+        const bool exists = i < ladder.count && ladder.levels[i].price == price;
+        if (size == 0) {
+            if (exists) {
+                std::memmove(&ladder.levels[i], &ladder.levels[i + 1],
+                             (ladder.count - i - 1) * sizeof(BookLevel));
+                --ladder.count;
+            }
+            return;
+        }
+        if (exists) {
+            ladder.levels[i].size = size;
+            return;
+        }
+        if (i == Depth) {
+            return;
+        }
+        const std::size_t moved = (ladder.count == Depth ? Depth - 1 : ladder.count) - i;
+        std::memmove(&ladder.levels[i + 1], &ladder.levels[i], moved * sizeof(BookLevel));
+        ladder.levels[i] = BookLevel{price, size};
+        if (ladder.count < Depth) {
+            ++ladder.count;
+        }
+    }
+
+    void clear() noexcept {
+        bids_.count = 0;
+        asks_.count = 0;
+    }
+
+    std::size_t depth(Side side) const noexcept {
+        return side == Side::Buy ? bids_.count : asks_.count;
+    }
+
+    // Level |i| from the best; only valid below depth(side).
+    const BookLevel& level(Side side, std::size_t i) const noexcept {
+        return side == Side::Buy ? bids_.levels[i] : asks_.levels[i];
+    }
+
+    // Size resting at exactly |price|, 0 when there is no such level.
+    Size sizeAt(Side side, Fixed price) const noexcept {
+        const Ladder& ladder = side == Side::Buy ? bids_ : asks_;
+        for (std::size_t i = 0; i < ladder.count; ++i) {
+            if (ladder.levels[i].price == price) {
+                return ladder.levels[i].size;
+            }
+        }
+        return 0;
+    }
+
+    // The existing top-of-book view; empty sides read as price and size 0.
+    Event top(PairId pair, Timestamp timestamp) const noexcept {
+        Event event{timestamp, pair, 0, 0, 0, 0};
+        if (bids_.count > 0) {
+            event.bidPrice = fromFixed(bids_.levels[0].price);
+            event.bidSize = bids_.levels[0].size;
+        }
+        if (asks_.count > 0) {
+            event.askPrice = fromFixed(asks_.levels[0].price);
+            event.askSize = asks_.levels[0].size;
+        }
+        return event;
+    }
+
+private:
+    struct Ladder {
+        std::array<BookLevel, Depth> levels;
+        std::size_t count = 0;
+    };
+
+    Ladder bids_{};
+    Ladder asks_{};
+};
+
+// Maintains an OrderBook per pair from DepthUpdate feed events and delivers
+// the top of book to the strategy through postEvent() whenever it changes,
+// so top-of-book consumers are unaffected while depth-aware ones read
+// book(pair). |Pairs| bounds the pair IDs, e.g. a PairUniverse's size();
+// updates for pairs outside it are dropped and counted.
+template <std::size_t Depth = 16, std::size_t Pairs = kMaxPairs>
+class BookBuilder {
+public:
+    static_assert(Pairs > 0 && Pairs <= kMaxPairs, "pair count must fit kMaxPairs");
+
+    explicit BookBuilder(Strategy& strategy) : strategy_(strategy) {}
+
+    void onDepth(const DepthUpdate& update) {
+        if (!contains(update.pair)) {
+            ++dropped_;
+            return;
+        }
+        OrderBook<Depth>& book = books_[update.pair];
+        const BookLevel bestBid = best(book, Side::Buy);
+        const BookLevel bestAsk = best(book, Side::Sell);
+        book.update(update.side, toFixed(update.price), update.size);
+        if (!same(bestBid, best(book, Side::Buy)) || !same(bestAsk, best(book, Side::Sell))) {
+            strategy_.postEvent(book.top(update.pair, update.timestamp));
+        }
+    }
+
+    // Top-of-book only feeds replace the first level on each side.
+    void onQuote(const Event& event) {
+        if (!contains(event.pair)) {
+            ++dropped_;
+            return;
+        }
+        OrderBook<Depth>& book = books_[event.pair];
+        book.clear();
+        book.update(Side::Buy, toFixed(event.bidPrice), event.bidSize);
+        book.update(Side::Sell, toFixed(event.askPrice), event.askSize);
+        strategy_.postEvent(event);
+    }
+
+    // |pair| must be below Pairs.
+    const OrderBook<Depth>& book(PairId pair) const noexcept { return books_[pair]; }
+
+    static constexpr bool contains(PairId pair) noexcept { return pair < Pairs; }
+
+    // Updates dropped for pairs outside Pairs.
+    std::uint64_t dropped() const noexcept { return dropped_; }
+
+private:
+    static BookLevel best(const OrderBook<Depth>& book, Side side) noexcept {
+        return book.depth(side) > 0 ? book.level(side, 0) : BookLevel{0, 0};
+    }
+
+    static bool same(const BookLevel& a, const BookLevel& b) noexcept {
+        return a.price == b.price && a.size == b.size;
+    }
+
+    Strategy& strategy_;
+    std::array<OrderBook<Depth>, Pairs> books_{};
+    std::uint64_t dropped_ = 0;
+};
+
+}  // namespace gts
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_map.hpp"
+#include "gts/order_registry.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/shm.hpp"
+#include "gts/spsc_ring.hpp"
+
+namespace gts {
+
+// Shared-memory order path for strategies running in separate processes.
+// The gateway process owns the real OrderSender (and with it the venue
+// socket and spot limit checks); each strategy gets a channel holding one
+// SPSC ring of requests towards the gateway and one of updates back.
+//
+// Order IDs seen by strategies are assigned by the client so sendOrder()
+// returns without a round trip; the gateway maps them to venue IDs.
+namespace gateway_detail {
+
+constexpr std::uint64_t kMagic = 0x475453474154454Full;  // "GTSGATEO"
+constexpr std::size_t kRingCapacity = 1 << 12;
+
+struct OrderRequest {
+    OrderId clientId;
+    Price price;
+    Size size;
+    PairId pair;
+    Side side;
+    Tif tif;
+};
+
+enum class UpdateType : std::uint8_t { Ack, Fill, Terminated };
+
+struct OrderUpdate {
+    OrderId clientId;
+    Price price;
+    Size size;
+    UpdateType type;
+};
+
+struct Channel {
+    std::atomic<std::uint64_t> magic;
+    // Set by the gateway when it gives up on a stalled client.
+    std::atomic<bool> disconnected;
+    SpscRing<OrderRequest, kRingCapacity> requests;
+    SpscRing<OrderUpdate, kRingCapacity> updates;
+};
+
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+}  // namespace gateway_detail
+
+// Runs in the gateway process. poll() forwards queued requests to |sender|
+// and every callback is pushed back to the owning strategy. A strategy whose
+// update ring stays full for |stallTimeout| is disconnected: the gateway
+// stops reading its requests and drops its updates, so one dead or stuck
+// process cannot block the venue callbacks and every other strategy. Its
+// orders already at the venue stay there.
+class OrderGateway : private OrderStateObserver {
+public:
+    explicit OrderGateway(OrderSender& sender,
+                          std::chrono::nanoseconds stallTimeout = std::chrono::milliseconds(10))
+        : sender_(sender), stallTimeout_(stallTimeout.count()) {}
+
+    // Creates the channel a GatewayClient opened with the same name uses.
+    void addClient(const std::string& name) {
+        auto shm = std::make_unique<SharedMemory>(
+            SharedMemory::create(name, sizeof(gateway_detail::Channel)));
+        auto* channel = new (shm->data()) gateway_detail::Channel{};
+        channel->magic.store(gateway_detail::kMagic, std::memory_order_release);
+        clients_.push_back(Client{std::move(shm), channel, false});
+    }
+
+    // Forwards every queued request; returns how many were sent.
+    std::size_t poll() {
+        std::size_t count = 0;
+        for (std::uint32_t index = 0; index < clients_.size(); ++index) {
+            gateway_detail::Channel& channel = *clients_[index].channel;
+            gateway_detail::OrderRequest req;
+            while (!clients_[index].disconnected && channel.requests.tryPop(req)) {
+                route(index, req);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool disconnected(std::uint32_t client) const noexcept { return clients_[client].disconnected; }
+
+    std::size_t disconnectedClients() const noexcept {
+        std::size_t count = 0;
+        for (const Client& client : clients_) count += client.disconnected ? 1 : 0;
+        return count;
+    }
+
+private:
+    struct Client {
+        std::unique_ptr<SharedMemory> shm;
+        gateway_detail::Channel* channel;
+        bool disconnected;
+    };
+
+    struct Route {
+        std::uint32_t client;
+        OrderId clientId;
+    };
+
+    void route(std::uint32_t client, const gateway_detail::OrderRequest& req) {
+        // Refused, by a local check or for lack of a route slot: tell the
+        // strategy the order is done.
+        if (!routes_.stage(Route{client, req.clientId}) ||
+            !routes_.commit(sender_.sendOrder(req.pair, req.side, req.price, req.size, req.tif,
+                                              *this))) {
+            push(client, {req.clientId, 0, 0, gateway_detail::UpdateType::Terminated});
+        }
+    }
+
+    // Updates are never dropped for a live client; a full ring means the
+    // strategy is behind, so wait for it, but only up to stallTimeout_.
+    void push(std::uint32_t client, const gateway_detail::OrderUpdate& update) noexcept {
+        Client& c = clients_[client];
+        if (c.disconnected || c.channel->updates.tryPush(update)) {
+            return;
+        }
+        const Timestamp deadline = nowNanos() + stallTimeout_;
+        do {
+            for (int i = 0; i < 64; ++i) {
+                gateway_detail::cpuRelax();
+            }
+            if (c.channel->updates.tryPush(update)) {
+                return;
+            }
+        } while (nowNanos() < deadline);
+        c.disconnected = true;
+        c.channel->disconnected.store(true, std::memory_order_release);
+    }
+
+    void forward(OrderId id, gateway_detail::UpdateType type, Price price, Size size) {
+        Route* r = type == gateway_detail::UpdateType::Ack ? routes_.ack(id) : routes_.update(id);
+        if (r != nullptr) {
+            push(r->client, {r->clientId, price, size, type});
+            if (type == gateway_detail::UpdateType::Terminated) {
+                routes_.erase(id);
+            }
+        }
+    }
+
+    void onAck(OrderId id) override {
+        forward(id, gateway_detail::UpdateType::Ack, 0, 0);
+    }
+
+    void onFill(OrderId id, Price price, Size size) override {
+        forward(id, gateway_detail::UpdateType::Fill, price, size);
+    }
+
+    void onTerminated(OrderId id) override {
+        forward(id, gateway_detail::UpdateType::Terminated, 0, 0);
+    }
+
+    OrderSender& sender_;
+    Timestamp stallTimeout_;
+    std::vector<Client> clients_;
+    OrderRegistry<Route, 1 << 14> routes_;
+};
+
+// Runs in a strategy process. sendOrder() only enqueues the request;
+// poll() delivers onAck/onFill/onTerminated to the observers.
+class GatewayClient : public OrderSender, public RestorableSender {
+public:
+    explicit GatewayClient(const std::string& name) : shm_(SharedMemory::open(name)) {
+        channel_ = static_cast<gateway_detail::Channel*>(shm_.data());
+        if (shm_.size() < sizeof(gateway_detail::Channel) ||
+            channel_->magic.load(std::memory_order_acquire) != gateway_detail::kMagic) {
+            throw std::runtime_error("GatewayClient: " + name + " is not a gateway channel");
+        }
+    }
+
+    // Returns kInvalidOrderId when the request ring or the observer table is
+    // full, or the gateway has disconnected this client.
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        const OrderId id = nextId_;
+        if (!connected() || observers_.insert(id, &observer) == nullptr) {
+            return kInvalidOrderId;
+        }
+        if (!channel_->requests.tryPush({id, price, size, pair, side, tif})) {
+            observers_.erase(id);
+            return kInvalidOrderId;
+        }
+        ++nextId_;
+        return id;
+    }
+
+    // The gateway keeps routing a restarted client's orders by client ID, so
+    // re-registering the observer is enough.
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        if (observers_.insert(order.id, &observer) == nullptr) {
+            throw std::length_error("GatewayClient: too many open orders to restore");
+        }
+        reserveOrderIds(order.id);
+    }
+
+    void reserveOrderIds(OrderId last) override { nextId_ = std::max(nextId_, last + 1); }
+
+    // False once the gateway gave up on this client for falling behind.
+    // Updates after that point were dropped, so open orders are unknown.
+    bool connected() const noexcept {
+        return !channel_->disconnected.load(std::memory_order_acquire);
+    }
+
+    std::size_t poll() {
+        std::size_t count = 0;
+        gateway_detail::OrderUpdate update;
+        while (channel_->updates.tryPop(update)) {
+            ++count;
+            OrderStateObserver** observer = observers_.find(update.clientId);
+            if (observer == nullptr) {
+                continue;
+            }
+            switch (update.type) {
+                case gateway_detail::UpdateType::Ack:
+                    (*observer)->onAck(update.clientId);
+                    break;
+                case gateway_detail::UpdateType::Fill:
+                    (*observer)->onFill(update.clientId, update.price, update.size);
+                    break;
+                case gateway_detail::UpdateType::Terminated: {
+                    OrderStateObserver* target = *observer;
+                    observers_.erase(update.clientId);
+                    target->onTerminated(update.clientId);
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+
+private:
+    SharedMemory shm_;
+    gateway_detail::Channel* channel_;
+    OrderId nextId_ = 1;
+    OrderMap<OrderStateObserver*> observers_;
+};
+
+}  // namespace gts
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+// Fixed-capacity open-addressing map from OrderId to V. Never allocates;
+// insert() fails when the table is full. erase() uses backward-shift deletion
+// so lookups never scan past tombstones, which means it may move other
+// entries: pointers returned by find() are invalidated by erase().
+template <typename V, std::size_t Capacity = 4096>
+class OrderMap {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    V* insert(OrderId id, const V& value) noexcept {
+        for (std::size_t i = 0, slot = hash(id); i < Capacity; ++i, slot = (slot + 1) & kMask) {
+            Entry& e = entries_[slot];
+            if (!e.used) {
+                e.id = id;
+                e.used = true;
+                e.value = value;
+                ++size_;
+                return &e.value;
+            }
+            if (e.id == id) {
+                e.value = value;
+                return &e.value;
+            }
+        }
+        return nullptr;
+    }
+
+    V* find(OrderId id) noexcept {
+        Entry* e = findEntry(id);
+        return e != nullptr ? &e->value : nullptr;
+    }
+
+    bool erase(OrderId id) noexcept {
+        Entry* e = findEntry(id);
+        if (e == nullptr) {
+            return false;
+        }
+        const std::size_t start = static_cast<std::size_t>(e - entries_);
+        std::size_t hole = start;
+        // In a full table there is no empty slot to stop at: stop after one
+        // lap instead.
+        for (std::size_t slot = (start + 1) & kMask; slot != start && entries_[slot].used;
+             slot = (slot + 1) & kMask) {
+            // Move the entry back into the hole unless its home slot lies
+            // cyclically in (hole, slot].
+            const std::size_t home = hash(entries_[slot].id);
+            const bool stays = hole <= slot ? (hole < home && home <= slot)
+                                            : (hole < home || home <= slot);
+            if (!stays) {
+                entries_[hole] = entries_[slot];
+                hole = slot;
+            }
+        }
+        entries_[hole].used = false;
+        --size_;
+        return true;
+    }
+
+    std::size_t size() const noexcept { return size_; }
+
+    template <typename F>
+    void forEach(F&& f) {
+        for (Entry& e : entries_) {
+            if (e.used) {
+                f(e.id, e.value);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        OrderId id;
+        bool used;
+        V value;
+    };
+
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    static std::size_t hash(OrderId id) noexcept {
+        return static_cast<std::size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) & kMask;
+    }
+
+    Entry* findEntry(OrderId id) noexcept {
+        for (std::size_t i = 0, slot = hash(id); i < Capacity; ++i, slot = (slot + 1) & kMask) {
+            Entry& e = entries_[slot];
+            if (!e.used) {
+                return nullptr;
+            }
+            if (e.id == id) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    Entry entries_[Capacity] = {};
+    std::size_t size_ = 0;
+};
+
+}  // namespace gts
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "gts/api.hpp"
+#include "gts/order_map.hpp"
+
+namespace gts {
+
+// Per-order state for an OrderSender decorator that observes the inner sender
+// itself. Venues may call back before sendOrder() returns the ID, so the
+// decorator stages the info for the order in flight before sending. It is
+// bound by the first ack for an unknown ID, or else by commit() with the ID
+// sendOrder() returned. A refused send (kInvalidOrderId) has no callbacks and
+// is never registered.
+//
+//   if (!registry_.stage(info)) return kInvalidOrderId;  // table full
+//   const OrderId id = inner_.sendOrder(..., *this);
+//   if (!registry_.commit(id)) { /* undo anything done; return kInvalidOrderId */ }
+//
+// Callbacks look the order up with ack() or update(). Only an ack binds: a
+// fill or termination for an unknown ID may be a late callback for an order
+// already erased, which must not take the staged info. If it was in fact for
+// the order in flight, the venue terminated it before acking it, and commit()
+// reports that order as refused.
+template <typename Info, std::size_t Capacity = 4096>
+class OrderRegistry {
+public:
+    // Returns false when the table is full; send nothing then, since none of
+    // the order's callbacks could be matched.
+    bool stage(const Info& info) noexcept {
+        if (orders_.size() >= Capacity) {
+            return false;
+        }
+        staged_ = info;
+        hasStaged_ = true;
+        unmatched_ = 0;
+        return true;
+    }
+
+    // Returns false if the order was refused or terminated before its ack;
+    // the staged info is dropped.
+    bool commit(OrderId id) noexcept {
+        if (!hasStaged_) {
+            // Bound by its ack, or nothing was staged.
+            return id != kInvalidOrderId;
+        }
+        hasStaged_ = false;
+        if (id == kInvalidOrderId) {
+            return false;
+        }
+        for (std::size_t i = 0; i < unmatched_ && i < kUnmatched; ++i) {
+            if (unmatchedIds_[i] == id) {
+                return false;
+            }
+        }
+        return orders_.insert(id, staged_) != nullptr;
+    }
+
+    // Lookup for an ack; binds the order in flight on its first ack.
+    Info* ack(OrderId id) noexcept {
+        Info* info = orders_.find(id);
+        if (info == nullptr && hasStaged_) {
+            hasStaged_ = false;
+            info = orders_.insert(id, staged_);
+        }
+        return info;
+    }
+
+    // Lookup for a fill or termination; never binds.
+    Info* update(OrderId id) noexcept {
+        Info* info = orders_.find(id);
+        if (info == nullptr && hasStaged_) {
+            unmatchedIds_[unmatched_++ % kUnmatched] = id;
+        }
+        return info;
+    }
+
+    Info* find(OrderId id) noexcept { return orders_.find(id); }
+
+    // True between stage() and commit() unless the order in flight was acked.
+    bool staging() const noexcept { return hasStaged_; }
+
+    // Registers an order sent outside this decorator, such as one restored
+    // from a snapshot. Returns nullptr when the table is full.
+    Info* insert(OrderId id, const Info& info) noexcept { return orders_.insert(id, info); }
+
+    bool erase(OrderId id) noexcept { return orders_.erase(id); }
+
+    std::size_t size() const noexcept { return orders_.size(); }
+
+    template <typename F>
+    void forEach(F&& f) {
+        orders_.forEach(f);
+    }
+
+private:
+    // Unknown IDs seen in fills and terminations during one send.
+    static constexpr std::size_t kUnmatched = 4;
+
+    Info staged_{};
+    bool hasStaged_ = false;
+    std::size_t unmatched_ = 0;
+    std::array<OrderId, kUnmatched> unmatchedIds_{};
+    OrderMap<Info, Capacity> orders_;
+};
+
+}  // namespace gts
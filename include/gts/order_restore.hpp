@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+enum class OrderState : std::uint8_t;  // order_state_machine.hpp
+
+// An order that was open when a session snapshot was taken.
+struct SnapshotOrder {
+    OrderId id;
+    Price price;
+    Size size;
+    Size remaining;
+    PairId pair;
+    Side side;
+    Tif tif;
+    OrderState state;
+};
+
+// Implemented by order senders that keep per-order state, so a warm restart
+// can re-register the orders still open at the venue through the whole
+// decorator chain. A decorator records the order, then passes it on to its
+// inner sender with itself as the observer (restoreOrderIn() below), so
+// later callbacks for the order flow through the chain as before the restart.
+class RestorableSender {
+public:
+    virtual ~RestorableSender() = default;
+
+    virtual void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) = 0;
+
+    // IDs up to |last| were handed out before the restart; senders that
+    // assign IDs must continue after it.
+    virtual void reserveOrderIds(OrderId last) = 0;
+};
+
+// Passes a restore on to |inner| when it keeps order state. Restores are
+// cold-path, so the lookup is a dynamic_cast rather than a new virtual on
+// the OrderSender API.
+inline void restoreOrderIn(OrderSender& inner, const SnapshotOrder& order,
+                           OrderStateObserver& observer) {
+    if (auto* restorable = dynamic_cast<RestorableSender*>(&inner)) {
+        restorable->restoreOrder(order, observer);
+    }
+}
+
+inline void reserveOrderIdsIn(OrderSender& inner, OrderId last) {
+    if (auto* restorable = dynamic_cast<RestorableSender*>(&inner)) {
+        restorable->reserveOrderIds(last);
+    }
+}
+
+// Base for OrderSender decorators that keep no per-order state of their own:
+// restores pass straight through to |inner_|.
+class ForwardingRestorableSender : public OrderSender, public RestorableSender {
+public:
+    explicit ForwardingRestorableSender(OrderSender& inner) : inner_(inner) {}
+
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        restoreOrderIn(inner_, order, observer);
+    }
+
+    void reserveOrderIds(OrderId last) override { reserveOrderIdsIn(inner_, last); }
+
+protected:
+    OrderSender& inner_;
+};
+
+}  // namespace gts
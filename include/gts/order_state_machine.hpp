@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_registry.hpp"
+#include "gts/order_restore.hpp"
+
+// Diagnostic mode records every invalid transition with its timestamp.
+// Without it the check is a single predictable branch and a counter.
+#ifndef GTS_ORDER_DIAGNOSTICS
+#ifdef NDEBUG
+#define GTS_ORDER_DIAGNOSTICS 0
+#else
+#define GTS_ORDER_DIAGNOSTICS 1
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define GTS_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define GTS_UNLIKELY(x) (x)
+#endif
+
+namespace gts {
+
+enum class OrderState : std::uint8_t { Sent, Acked, PartiallyFilled, Filled, Terminated, Invalid };
+enum class OrderEvent : std::uint8_t { Ack, PartialFill, Fill, Terminate };
+
+constexpr std::size_t kOrderStates = 5;
+constexpr std::size_t kOrderEvents = 4;
+
+// GTC/IOC lifecycle: sent -> acked -> partially filled -> filled/terminated.
+// Orders refused by the venue may terminate without an ack.
+constexpr OrderState kOrderTransitions[kOrderStates][kOrderEvents] = {
+    //               Ack                    PartialFill                  Fill                  Terminate
+    /* Sent */       {OrderState::Acked,   OrderState::Invalid,         OrderState::Invalid,  OrderState::Terminated},
+    /* Acked */      {OrderState::Invalid, OrderState::PartiallyFilled, OrderState::Filled,   OrderState::Terminated},
+    /* Partially */  {OrderState::Invalid, OrderState::PartiallyFilled, OrderState::Filled,   OrderState::Terminated},
+    /* Filled */     {OrderState::Invalid, OrderState::Invalid,         OrderState::Invalid,  OrderState::Terminated},
+    /* Terminated */ {OrderState::Invalid, OrderState::Invalid,         OrderState::Invalid,  OrderState::Invalid},
+};
+
+constexpr OrderState nextOrderState(OrderState state, OrderEvent event) noexcept {
+    return kOrderTransitions[static_cast<std::size_t>(state)][static_cast<std::size_t>(event)];
+}
+
+struct OrderViolation {
+    Timestamp timestamp;
+    OrderId id;
+    OrderState state;
+    OrderEvent event;
+};
+
+// OrderSender decorator that runs every order through the lifecycle table.
+// Callbacks are always forwarded; invalid transitions leave the state as is
+// and are counted (and, in diagnostic mode, recorded). Callbacks for IDs it
+// no longer tracks are treated as arriving after termination. It also keeps
+// the open order table that session snapshots capture.
+class OrderLifecycle : public OrderSender, public RestorableSender, private OrderStateObserver {
+public:
+    static constexpr std::size_t kViolationLog = 1024;
+
+    explicit OrderLifecycle(OrderSender& inner) : inner_(inner) {}
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        if (!orders_.stage(Order{OrderState::Sent, size, &observer, price, size, pair, side, tif})) {
+            return kInvalidOrderId;
+        }
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, *this);
+        if (!orders_.commit(id)) {
+            return kInvalidOrderId;
+        }
+        lastId_ = std::max(lastId_, id);
+        return id;
+    }
+
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        orders_.insert(order.id, Order{order.state, order.remaining, &observer, order.price,
+                                       order.size, order.pair, order.side, order.tif});
+        lastId_ = std::max(lastId_, order.id);
+        restoreOrderIn(inner_, order, *this);
+    }
+
+    void reserveOrderIds(OrderId last) override {
+        lastId_ = std::max(lastId_, last);
+        reserveOrderIdsIn(inner_, last);
+    }
+
+    // Visits every open order as a SnapshotOrder.
+    template <typename F>
+    void forEachOrder(F&& f) {
+        orders_.forEach([&](OrderId id, const Order& o) {
+            f(SnapshotOrder{id, o.price, o.size, o.remaining, o.pair, o.side, o.tif, o.state});
+        });
+    }
+
+    // Highest order ID sent so far.
+    OrderId lastOrderId() const noexcept { return lastId_; }
+
+    OrderState state(OrderId id) noexcept {
+        const Order* order = orders_.find(id);
+        return order != nullptr ? order->state : OrderState::Terminated;
+    }
+
+    std::uint64_t violations() const noexcept { return violations_; }
+
+#if GTS_ORDER_DIAGNOSTICS
+    // The most recent violations, oldest first once the log has wrapped.
+    template <typename F>
+    void forEachViolation(F&& f) const {
+        const std::uint64_t first = violations_ > kViolationLog ? violations_ - kViolationLog : 0;
+        for (std::uint64_t i = first; i < violations_; ++i) {
+            f(violationLog_[i % kViolationLog]);
+        }
+    }
+#endif
+
+private:
+    struct Order {
+        OrderState state;
+        Size remaining;
+        OrderStateObserver* observer;
+        Price price;
+        Size size;
+        PairId pair;
+        Side side;
+        Tif tif;
+    };
+
+    // Applies |event|; returns false for an invalid transition.
+    bool apply(OrderId id, Order* order, OrderEvent event) noexcept {
+        const OrderState from = order != nullptr ? order->state : OrderState::Terminated;
+        const OrderState to = nextOrderState(from, event);
+        if (GTS_UNLIKELY(to == OrderState::Invalid)) {
+#if GTS_ORDER_DIAGNOSTICS
+            violationLog_[violations_ % kViolationLog] = OrderViolation{nowNanos(), id, from, event};
+#else
+            (void)id;
+#endif
+            ++violations_;
+            return false;
+        }
+        order->state = to;
+        return true;
+    }
+
+    void onAck(OrderId id) override {
+        Order* order = orders_.ack(id);
+        apply(id, order, OrderEvent::Ack);
+        if (order != nullptr) {
+            order->observer->onAck(id);
+        }
+    }
+
+    void onFill(OrderId id, Price price, Size size) override {
+        Order* order = orders_.update(id);
+        if (order != nullptr) {
+            order->remaining -= size;
+        }
+        const bool complete = order == nullptr || order->remaining <= 0;
+        apply(id, order, complete ? OrderEvent::Fill : OrderEvent::PartialFill);
+        if (order != nullptr) {
+            order->observer->onFill(id, price, size);
+        }
+    }
+
+    void onTerminated(OrderId id) override {
+        Order* order = orders_.update(id);
+        if (order == nullptr && orders_.staging()) {
+            // Possibly the order in flight rejected without an ack, which
+            // sendOrder() then reports as refused: not a violation.
+            return;
+        }
+        apply(id, order, OrderEvent::Terminate);
+        if (order != nullptr) {
+            OrderStateObserver* observer = order->observer;
+            orders_.erase(id);
+            observer->onTerminated(id);
+        }
+    }
+
+    OrderSender& inner_;
+    OrderRegistry<Order> orders_;
+    OrderId lastId_ = 0;
+    std::uint64_t violations_ = 0;
+#if GTS_ORDER_DIAGNOSTICS
+    std::array<OrderViolation, kViolationLog> violationLog_{};
+#endif
+};
+
+}  // namespace gts
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+struct PairSpec {
+    std::string_view ccy1;
+    std::string_view ccy2;
+};
+
+// The traded CCY1/CCY2 pairs, fixed at build time. A pair's ID is its index
+// in the list, and id() resolves names at compile time when used in a
+// constant expression, so no string or map lookup is left on the hot path.
+// Order books, the bulk of per-pair state, can be sized to the universe;
+// other components keep small arrays of kMaxPairs entries indexed by PairId:
+//
+//   inline constexpr auto kPairs = gts::makePairUniverse({
+//       {"EUR", "USD"}, {"USD", "JPY"}, {"EUR", "JPY"},
+//   });
+//   constexpr gts::PairId kEurUsd = kPairs.id("EUR", "USD");
+//   gts::BookBuilder<16, kPairs.size()> books(strategy);
+template <std::size_t N>
+struct PairUniverse {
+    static_assert(N > 0 && N <= kMaxPairs, "pair universe must fit kMaxPairs");
+
+    std::array<PairSpec, N> pairs;
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+    // An unknown pair is a compile error in constant expressions.
+    constexpr PairId id(std::string_view ccy1, std::string_view ccy2) const {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (pairs[i].ccy1 == ccy1 && pairs[i].ccy2 == ccy2) {
+                return static_cast<PairId>(i);
+            }
+        }
+        throw std::invalid_argument("pair is not in the universe");
+    }
+
+    constexpr bool contains(PairId pair) const noexcept { return pair < N; }
+
+    constexpr const PairSpec& operator[](PairId pair) const noexcept { return pairs[pair]; }
+};
+
+template <std::size_t N>
+constexpr PairUniverse<N> makePairUniverse(const PairSpec (&pairs)[N]) {
+    PairUniverse<N> universe{};
+    for (std::size_t i = 0; i < N; ++i) {
+        universe.pairs[i] = pairs[i];
+    }
+    return universe;
+}
+
+// Registers every pair of |universe| with an engine exposing
+// addPair(PairId, ccy1, ccy2), e.g. CrossRateEngine.
+template <typename Engine, std::size_t N>
+void addPairs(Engine& engine, const PairUniverse<N>& universe) {
+    for (std::size_t i = 0; i < N; ++i) {
+        const std::string ccy1(universe.pairs[i].ccy1);
+        const std::string ccy2(universe.pairs[i].ccy2);
+        engine.addPair(static_cast<PairId>(i), ccy1.c_str(), ccy2.c_str());
+    }
+}
+
+}  // namespace gts
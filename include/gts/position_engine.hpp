@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/fixed_point.hpp"
+#include "gts/order_registry.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/seqlock.hpp"
+
+namespace gts {
+
+// Per-pair position as seen by monitoring threads. CCY2 amounts and PnL are
+// Fixed values in CCY2.
+struct PositionSnapshot {
+    Timestamp updated;
+    Size ccy1Position;
+    Fixed ccy2Position;
+    Fixed averagePrice;
+    Fixed markPrice;
+    Fixed realizedPnl;
+    Fixed unrealizedPnl;
+};
+
+// Incremental per-pair position and PnL. onFill() and onEvent() must be
+// called from the strategy thread; snapshot() may be called from any thread.
+// Longs are marked at the bid and shorts at the ask.
+class PositionEngine {
+public:
+    void onFill(PairId pair, Side side, Price price, Size size,
+                Timestamp timestamp = nowNanos()) noexcept {
+        PairState& s = state_[pair];
+        const Fixed fillPrice = toFixed(price);
+        const Size signedSize = side == Side::Buy ? size : -size;
+        s.cash -= mulDiv(signedSize, fillPrice, 1);
+
+        if (s.position == 0 || (s.position > 0) == (signedSize > 0)) {
+            const Size total = std::llabs(s.position) + size;
+            s.averagePrice = static_cast<Fixed>(
+                (static_cast<__int128>(s.averagePrice) * std::llabs(s.position) +
+                 static_cast<__int128>(fillPrice) * size) / total);
+            s.position += signedSize;
+        } else {
+            const Size closing = std::min<Size>(std::llabs(s.position), size);
+            const Size direction = s.position > 0 ? 1 : -1;
+            s.realizedPnl += mulDiv(fillPrice - s.averagePrice, closing * direction, 1);
+            const Size before = s.position;
+            s.position += signedSize;
+            if (s.position == 0) {
+                s.averagePrice = 0;
+            } else if ((s.position > 0) != (before > 0)) {
+                s.averagePrice = fillPrice;
+            }
+        }
+        publish(pair, timestamp);
+    }
+
+    // Mark-to-market on every top of book update.
+    void onEvent(const Event& event) noexcept {
+        PairState& s = state_[event.pair];
+        s.bid = toFixed(event.bidPrice);
+        s.ask = toFixed(event.askPrice);
+        publish(event.pair, event.timestamp);
+    }
+
+    PositionSnapshot snapshot(PairId pair) const noexcept {
+        return snapshots_[pair].load();
+    }
+
+    // Reinstates a position saved with snapshot(), e.g. after a restart.
+    void restore(PairId pair, const PositionSnapshot& snap) noexcept {
+        PairState& s = state_[pair];
+        s.position = snap.ccy1Position;
+        s.cash = snap.ccy2Position;
+        s.averagePrice = snap.averagePrice;
+        s.realizedPnl = snap.realizedPnl;
+        publish(pair, snap.updated);
+    }
+
+private:
+    struct PairState {
+        Size position = 0;
+        Fixed cash = 0;
+        Fixed averagePrice = 0;
+        Fixed realizedPnl = 0;
+        Fixed bid = 0;
+        Fixed ask = 0;
+    };
+
+    void publish(PairId pair, Timestamp timestamp) noexcept {
+        const PairState& s = state_[pair];
+        PositionSnapshot snap;
+        snap.updated = timestamp;
+        snap.ccy1Position = s.position;
+        snap.ccy2Position = s.cash;
+        snap.averagePrice = s.averagePrice;
+        if (s.position > 0) {
+            snap.markPrice = s.bid;
+        } else if (s.position < 0) {
+            snap.markPrice = s.ask;
+        } else {
+            snap.markPrice = (s.bid + s.ask) / 2;
+        }
+        snap.realizedPnl = s.realizedPnl;
+        snap.unrealizedPnl = s.position == 0 || snap.markPrice == 0
+                                 ? 0
+                                 : mulDiv(snap.markPrice - s.averagePrice, s.position, 1);
+        snapshots_[pair].store(snap);
+    }
+
+    std::array<PairState, kMaxPairs> state_{};
+    std::array<Seqlock<PositionSnapshot>, kMaxPairs> snapshots_;
+};
+
+// OrderSender decorator that feeds fills into a PositionEngine. It remembers
+// pair, side and the caller's observer per order, observes the inner sender
+// itself and forwards every callback.
+class PositionTracker : public OrderSender, public RestorableSender, private OrderStateObserver {
+public:
+    PositionTracker(OrderSender& inner, PositionEngine& engine)
+        : inner_(inner), engine_(engine) {}
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        if (!orders_.stage(OrderInfo{pair, side, &observer})) {
+            return kInvalidOrderId;
+        }
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, *this);
+        return orders_.commit(id) ? id : kInvalidOrderId;
+    }
+
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        orders_.insert(order.id, OrderInfo{order.pair, order.side, &observer});
+        restoreOrderIn(inner_, order, *this);
+    }
+
+    void reserveOrderIds(OrderId last) override { reserveOrderIdsIn(inner_, last); }
+
+private:
+    struct OrderInfo {
+        PairId pair;
+        Side side;
+        OrderStateObserver* observer;
+    };
+
+    void onAck(OrderId id) override {
+        if (OrderInfo* info = orders_.ack(id)) {
+            info->observer->onAck(id);
+        }
+    }
+
+    void onFill(OrderId id, Price price, Size size) override {
+        if (OrderInfo* info = orders_.update(id)) {
+            engine_.onFill(info->pair, info->side, price, size);
+            info->observer->onFill(id, price, size);
+        }
+    }
+
+    void onTerminated(OrderId id) override {
+        if (OrderInfo* info = orders_.update(id)) {
+            OrderStateObserver* observer = info->observer;
+            orders_.erase(id);
+            observer->onTerminated(id);
+        }
+    }
+
+    OrderSender& inner_;
+    PositionEngine& engine_;
+    OrderRegistry<OrderInfo> orders_;
+};
+
+}  // namespace gts
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "gts/api.hpp"
+#include "gts/tsc_clock.hpp"
+
+// Probes are compiled in only with GTS_PROFILING=1; otherwise the macros
+// expand to nothing. GTS_PROFILE_STAGE_AS names the probe so the scope can
+// drop its sample with GTS_PROFILE_DISCARD, e.g. an empty socket poll.
+#ifndef GTS_PROFILING
+#define GTS_PROFILING 0
+#endif
+
+#define GTS_PROFILE_CONCAT_(a, b) a##b
+#define GTS_PROFILE_CONCAT(a, b) GTS_PROFILE_CONCAT_(a, b)
+
+#if GTS_PROFILING
+#define GTS_PROFILE_STAGE_AS(name, stage) ::gts::StageTimer name(::gts::Stage::stage)
+#define GTS_PROFILE_DISCARD(name) name.discard()
+#else
+#define GTS_PROFILE_STAGE_AS(name, stage) static_cast<void>(0)
+#define GTS_PROFILE_DISCARD(name) static_cast<void>(0)
+#endif
+#define GTS_PROFILE_STAGE(stage) \
+    GTS_PROFILE_STAGE_AS(GTS_PROFILE_CONCAT(gtsStageTimer, __LINE__), stage)
+
+namespace gts {
+
+// Stages between a tick arriving on the socket and the order leaving it.
+// Every stage is timed exclusive of stages nested inside it, so they do not
+// overlap, except PostEvent: it is the whole postEvent() call, and its time
+// outside nested stages (risk checks, wire writes) is StrategyLogic.
+enum class Stage : std::uint8_t {
+    SocketRead,
+    Decode,
+    PostEvent,
+    StrategyLogic,
+    RiskCheck,
+    WireWrite,
+    Count,
+};
+
+constexpr const char* stageName(Stage stage) noexcept {
+    constexpr const char* kNames[] = {"socket_read", "decode",    "post_event",
+                                      "strategy",    "risk_check", "wire_write"};
+    return kNames[static_cast<std::size_t>(stage)];
+}
+
+// Hardware counters collected around postEvent() when available.
+enum class PerfCounter : std::uint8_t { Cycles, Instructions, CacheMisses, BranchMisses, Count };
+
+// Per-stage TSC tick aggregates. Probes are expected on the single hot-path
+// thread: counters use relaxed load/store instead of atomic read-modify-write,
+// and report() may run concurrently from an exporter thread.
+class StageProfiler {
+public:
+    static StageProfiler& instance() {
+        static StageProfiler profiler;
+        return profiler;
+    }
+
+    void record(Stage stage, std::uint64_t ticks) noexcept {
+        Stat& s = stats_[static_cast<std::size_t>(stage)];
+        bump(s.count, 1);
+        bump(s.ticks, ticks);
+        if (ticks > s.maxTicks.load(std::memory_order_relaxed)) {
+            s.maxTicks.store(ticks, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t count(Stage stage) const noexcept {
+        return stats_[static_cast<std::size_t>(stage)].count.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t ticks(Stage stage) const noexcept {
+        return stats_[static_cast<std::size_t>(stage)].ticks.load(std::memory_order_relaxed);
+    }
+
+    void recordPerf(const std::uint64_t (&deltas)[static_cast<std::size_t>(PerfCounter::Count)]) noexcept {
+        bump(perfSamples_, 1);
+        for (std::size_t i = 0; i < static_cast<std::size_t>(PerfCounter::Count); ++i) {
+            bump(perf_[i], deltas[i]);
+        }
+    }
+
+    // Writes mean/max nanoseconds per stage and per-postEvent hardware
+    // counter averages.
+    void report(std::FILE* out) const {
+        const double ticksPerNano = TscClock::instance().ticksPerNano();
+        std::fprintf(out, "%-12s %12s %12s %12s\n", "stage", "count", "mean_ns", "max_ns");
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Stage::Count); ++i) {
+            const Stat& s = stats_[i];
+            const std::uint64_t count = s.count.load(std::memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            const double mean = static_cast<double>(s.ticks.load(std::memory_order_relaxed)) /
+                                static_cast<double>(count) / ticksPerNano;
+            const double max =
+                static_cast<double>(s.maxTicks.load(std::memory_order_relaxed)) / ticksPerNano;
+            std::fprintf(out, "%-12s %12llu %12.1f %12.1f\n", stageName(static_cast<Stage>(i)),
+                         static_cast<unsigned long long>(count), mean, max);
+        }
+        const std::uint64_t samples = perfSamples_.load(std::memory_order_relaxed);
+        if (samples > 0) {
+            constexpr const char* kNames[] = {"cycles", "instructions", "cache_misses",
+                                              "branch_misses"};
+            std::fprintf(out, "postEvent hardware counters (per call, %llu calls)\n",
+                         static_cast<unsigned long long>(samples));
+            for (std::size_t i = 0; i < static_cast<std::size_t>(PerfCounter::Count); ++i) {
+                std::fprintf(out, "  %-14s %12.1f\n", kNames[i],
+                             static_cast<double>(perf_[i].load(std::memory_order_relaxed)) /
+                                 static_cast<double>(samples));
+            }
+        }
+        std::fflush(out);
+    }
+
+private:
+    struct Stat {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> ticks{0};
+        std::atomic<std::uint64_t> maxTicks{0};
+    };
+
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t by) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    Stat stats_[static_cast<std::size_t>(Stage::Count)];
+    std::atomic<std::uint64_t> perf_[static_cast<std::size_t>(PerfCounter::Count)] = {};
+    std::atomic<std::uint64_t> perfSamples_{0};
+};
+
+// Scoped probe; use through GTS_PROFILE_STAGE so it compiles out. Timers on
+// a thread form a stack so each can subtract the time of those nested in it.
+class StageTimer {
+public:
+    explicit StageTimer(Stage stage) noexcept
+        : stage_(stage), parent_(current()), start_(TscClock::readTsc()) {
+        current() = this;
+    }
+
+    ~StageTimer() {
+        const std::uint64_t total = TscClock::readTsc() - start_;
+        current() = parent_;
+        if (discarded_) {
+            return;
+        }
+        if (parent_ != nullptr) {
+            parent_->nested_ += total;
+        }
+        StageProfiler& profiler = StageProfiler::instance();
+        if (stage_ == Stage::PostEvent) {
+            profiler.record(Stage::PostEvent, total);
+            profiler.record(Stage::StrategyLogic, total - nested_);
+        } else {
+            profiler.record(stage_, total - nested_);
+        }
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+    // Drops this sample, e.g. a poll that found nothing to read.
+    void discard() noexcept { discarded_ = true; }
+
+private:
+    static StageTimer*& current() noexcept {
+        thread_local StageTimer* timer = nullptr;
+        return timer;
+    }
+
+    Stage stage_;
+    StageTimer* parent_;
+    std::uint64_t start_;
+    std::uint64_t nested_ = 0;
+    bool discarded_ = false;
+};
+
+// Group of perf_event hardware counters for the calling thread. available()
+// is false when the kernel refuses (no PMU access, paranoid setting).
+class PerfCounters {
+public:
+    static constexpr std::size_t kCount = static_cast<std::size_t>(PerfCounter::Count);
+
+    PerfCounters() {
+        constexpr std::uint64_t kConfigs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                              PERF_COUNT_HW_CACHE_MISSES,
+                                              PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::size_t i = 0; i < kCount; ++i) {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = kConfigs[i];
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            fds_[i] = static_cast<int>(
+                ::syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+            if (fds_[i] < 0) {
+                close();
+                return;
+            }
+        }
+        ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const noexcept { return fds_[0] >= 0; }
+
+    bool read(std::uint64_t (&values)[kCount]) const noexcept {
+        struct {
+            std::uint64_t nr;
+            std::uint64_t values[kCount];
+        } group;
+        if (::read(fds_[0], &group, sizeof(group)) != static_cast<ssize_t>(sizeof(group))) {
+            return false;
+        }
+        for (std::size_t i = 0; i < kCount; ++i) {
+            values[i] = group.values[i];
+        }
+        return true;
+    }
+
+private:
+    void close() noexcept {
+        for (int& fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    int fds_[kCount] = {-1, -1, -1, -1};
+};
+
+// Strategy decorator that times postEvent() as the PostEvent stage and,
+// when |counters| is given and available, accumulates hardware counter
+// deltas around each call.
+class ProfiledStrategy : public Strategy {
+public:
+    explicit ProfiledStrategy(Strategy& inner, const PerfCounters* counters = nullptr)
+        : inner_(inner),
+          counters_(counters != nullptr && counters->available() ? counters : nullptr) {}
+
+    void postEvent(const Event& event) override {
+        if (counters_ == nullptr) {
+            GTS_PROFILE_STAGE(PostEvent);
+            inner_.postEvent(event);
+            return;
+        }
+        std::uint64_t before[PerfCounters::kCount];
+        std::uint64_t after[PerfCounters::kCount];
+        const bool ok = counters_->read(before);
+        {
+            GTS_PROFILE_STAGE(PostEvent);
+            inner_.postEvent(event);
+        }
+        if (ok && counters_->read(after)) {
+            for (std::size_t i = 0; i < PerfCounters::kCount; ++i) {
+                after[i] -= before[i];
+            }
+            StageProfiler::instance().recordPerf(after);
+        }
+    }
+
+private:
+    Strategy& inner_;
+    const PerfCounters* counters_;
+};
+
+// Writes StageProfiler::report() to |out| every |period|.
+class ProfileExporter {
+public:
+    ProfileExporter(std::FILE* out, std::chrono::milliseconds period = std::chrono::seconds(10))
+        : out_(out), period_(period), worker_([this] { run(); }) {}
+
+    ~ProfileExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        worker_.join();
+        StageProfiler::instance().report(out_);
+    }
+
+    ProfileExporter(const ProfileExporter&) = delete;
+    ProfileExporter& operator=(const ProfileExporter&) = delete;
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!wakeup_.wait_for(lock, period_, [this] { return stopping_; })) {
+            StageProfiler::instance().report(out_);
+        }
+    }
+
+    std::FILE* out_;
+    std::chrono::milliseconds period_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
+
+}  // namespace gts
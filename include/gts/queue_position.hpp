@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "gts/api.hpp"
+#include "gts/events.hpp"
+#include "gts/fixed_point.hpp"
+
+namespace gts {
+
+// Estimates how much size rests ahead of our GTC orders at their price.
+//
+// On entry everything visible at the level is ahead of us. Trades at our
+// price consume the queue from the front. Any other decrease of the level is
+// cancellations, spread over the queue in proportion, so the part ahead of us
+// shrinks by its share. Increases join behind us. A fill means we reached
+// the front.
+//
+// track() returns a handle that strategies keep with the order (e.g. in a
+// TaggedOrderSender tag), so queueAhead() is a single array read. When all
+// kMaxOrders slots are in use it returns kNoHandle, which the other calls
+// accept: the order is simply not estimated.
+class QueuePositionEstimator {
+public:
+    using Handle = std::uint16_t;
+    static constexpr std::size_t kMaxOrders = 256;
+    static constexpr Handle kNoHandle = static_cast<Handle>(~Handle{0});
+
+    // Starts tracking an order resting at |price| once acked, with
+    // |levelSize| the visible size at that price excluding our order.
+    Handle track(PairId pair, Side side, Price price, Size size, Size levelSize) noexcept {
+        for (std::size_t i = 0; i < kMaxOrders; ++i) {
+            Tracked& t = orders_[i];
+            if (!t.active) {
+                t = Tracked{toFixed(price), levelSize, size, levelSize + size, 0, pair, side, true};
+                return static_cast<Handle>(i);
+            }
+        }
+        return kNoHandle;
+    }
+
+    void untrack(Handle handle) noexcept {
+        if (handle < kMaxOrders) {
+            orders_[handle].active = false;
+        }
+    }
+
+    // An order without a handle is assumed to be at the back of the queue.
+    Size queueAhead(Handle handle) const noexcept {
+        return handle < kMaxOrders ? orders_[handle].ahead : std::numeric_limits<Size>::max();
+    }
+
+    // Our fills come from the front of the queue.
+    void onFill(Handle handle, Size size) noexcept {
+        if (handle >= kMaxOrders) {
+            return;
+        }
+        Tracked& t = orders_[handle];
+        t.ahead = 0;
+        t.remaining -= size;
+        t.levelSize -= size;
+    }
+
+    void onTrade(const Trade& trade) noexcept {
+        const Fixed price = toFixed(trade.price);
+        for (Tracked& t : orders_) {
+            if (t.active && t.pair == trade.pair && t.price == price) {
+                t.traded += trade.size;
+            }
+        }
+    }
+
+    // Visible size at |price| on |side| changed to |size| (our order
+    // included).
+    void onLevel(PairId pair, Side side, Fixed price, Size size) noexcept {
+        for (Tracked& t : orders_) {
+            if (t.active && t.pair == pair && t.side == side && t.price == price) {
+                apply(t, size);
+            }
+        }
+    }
+
+    // Top-of-book feed: only the touch level is visible.
+    void onEvent(const Event& event) noexcept {
+        onLevel(event.pair, Side::Buy, toFixed(event.bidPrice), event.bidSize);
+        onLevel(event.pair, Side::Sell, toFixed(event.askPrice), event.askSize);
+    }
+
+private:
+    struct Tracked {
+        Fixed price;
+        Size ahead;
+        Size remaining;
+        Size levelSize;
+        Size traded;
+        PairId pair;
+        Side side;
+        bool active;
+    };
+
+    static void apply(Tracked& t, Size size) noexcept {
+        const Size decrease = t.levelSize - size;
+        if (decrease > 0) {
+            const Size fromTrades = std::min(decrease, t.traded);
+            t.ahead -= std::min(t.ahead, fromTrades);
+            const Size cancelled = decrease - fromTrades;
+            const Size others = t.levelSize - fromTrades - t.remaining;
+            if (cancelled > 0 && others > 0 && t.ahead > 0) {
+                t.ahead -= std::min(t.ahead, mulDiv(cancelled, t.ahead, others));
+            }
+        }
+        t.traded = 0;
+        t.levelSize = size;
+    }
+
+    std::array<Tracked, kMaxOrders> orders_{};
+};
+
+}  // namespace gts
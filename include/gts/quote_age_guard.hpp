@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_restore.hpp"
+
+namespace gts {
+
+enum class StaleQuoteAction : std::uint8_t {
+    // Refuse the order with kInvalidOrderId.
+    Reject,
+    // Send it with the limit moved away from the market by the reprice
+    // offset, so a stale view cannot cross at a bad price.
+    Reprice,
+};
+
+// OrderSender decorator that checks the age of the last quote for the order's
+// pair before sending. onEvent() caches the per-pair local receive time; the
+// pre-send check is one subtraction and one compare. Ages are measured on the
+// local clock only, so venue clock offset and feed latency do not skew them.
+class QuoteAgeGuard : public ForwardingRestorableSender {
+public:
+    QuoteAgeGuard(OrderSender& inner, Timestamp maxAge,
+                  StaleQuoteAction action = StaleQuoteAction::Reject, Price repriceOffset = 0)
+        : ForwardingRestorableSender(inner),
+          maxAge_(maxAge),
+          action_(action),
+          repriceOffset_(repriceOffset) {}
+
+    // Feed every event the strategy sees, typically first thing in postEvent().
+    // |receivedAt| is the local receive time, not the venue timestamp.
+    void onEvent(const Event& event, Timestamp receivedAt = nowNanos()) noexcept {
+        lastUpdate_[event.pair] = receivedAt;
+    }
+
+    bool isFresh(PairId pair, Timestamp now = nowNanos()) const noexcept {
+        return now - lastUpdate_[pair] <= maxAge_;
+    }
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        return sendOrder(pair, side, price, size, tif, observer, nowNanos());
+    }
+
+    // As sendOrder() above, with the quote age measured at |now|.
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer, Timestamp now) {
+        if (!isFresh(pair, now)) {
+            ++stale_;
+            if (action_ == StaleQuoteAction::Reject) {
+                return kInvalidOrderId;
+            }
+            price += side == Side::Buy ? -repriceOffset_ : repriceOffset_;
+        }
+        return inner_.sendOrder(pair, side, price, size, tif, observer);
+    }
+
+    std::uint64_t staleOrders() const noexcept { return stale_; }
+
+private:
+    Timestamp maxAge_;
+    StaleQuoteAction action_;
+    Price repriceOffset_;
+    std::array<Timestamp, kMaxPairs> lastUpdate_{};
+    std::uint64_t stale_ = 0;
+};
+
+}  // namespace gts
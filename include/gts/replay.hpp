@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "gts/api.hpp"
+#include "gts/events.hpp"
+
+namespace gts {
+
+// Recorded ticks: a TickFileHeader followed by raw FeedEvents in feed order.
+// One file is one shard, typically one day or one pair. FeedEvent is
+// trivially copyable, so files are only portable between identical builds;
+// recordSize catches the common mismatch.
+struct TickFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+constexpr char kTickMagic[8] = {'G', 'T', 'S', 'T', 'I', 'C', 'K', 'S'};
+constexpr std::uint32_t kTickVersion = 1;
+
+// Writes a tick file. Call close() when done: it flushes the file and throws
+// if any write failed, so a short file is never mistaken for a whole shard.
+// The destructor closes without checking.
+class TickFileWriter {
+public:
+    explicit TickFileWriter(const std::string& path)
+        : path_(path), file_(std::fopen(path.c_str(), "wb")) {
+        if (file_ == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "fopen " + path);
+        }
+        TickFileHeader header{};
+        std::copy(std::begin(kTickMagic), std::end(kTickMagic), header.magic);
+        header.version = kTickVersion;
+        header.recordSize = sizeof(FeedEvent);
+        if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+            const int err = errno;
+            std::fclose(file_);
+            throw std::system_error(err, std::generic_category(), "fwrite " + path);
+        }
+    }
+
+    ~TickFileWriter() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    TickFileWriter(const TickFileWriter&) = delete;
+    TickFileWriter& operator=(const TickFileWriter&) = delete;
+
+    void append(const FeedEvent& event) {
+        if (std::fwrite(&event, sizeof(event), 1, file_) != 1) {
+            throw std::system_error(errno, std::generic_category(), "fwrite " + path_);
+        }
+    }
+
+    void close() {
+        if (file_ == nullptr) {
+            return;
+        }
+        std::FILE* file = file_;
+        file_ = nullptr;
+        if (std::fclose(file) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fclose " + path_);
+        }
+    }
+
+private:
+    std::string path_;
+    std::FILE* file_;
+};
+
+// Reads a whole tick file in one pass; replay then runs from memory.
+inline std::vector<FeedEvent> loadTickFile(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::system_error(errno, std::generic_category(), "fopen " + path);
+    }
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> guard(file, &std::fclose);
+    TickFileHeader header{};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        !std::equal(std::begin(kTickMagic), std::end(kTickMagic), header.magic) ||
+        header.version != kTickVersion || header.recordSize != sizeof(FeedEvent)) {
+        throw std::runtime_error("not a compatible tick file: " + path);
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long end = std::ftell(file);
+    if (end < 0) {
+        throw std::system_error(errno, std::generic_category(), "ftell " + path);
+    }
+    std::fseek(file, sizeof(header), SEEK_SET);
+    const std::size_t bytes = static_cast<std::size_t>(end) - sizeof(header);
+    if (bytes % sizeof(FeedEvent) != 0) {
+        // A writer that died mid-record: the tail is not a whole event.
+        throw std::runtime_error("truncated tick file: " + path);
+    }
+    std::vector<FeedEvent> events(bytes / sizeof(FeedEvent));
+    if (std::fread(events.data(), sizeof(FeedEvent), events.size(), file) != events.size()) {
+        throw std::runtime_error("truncated tick file: " + path);
+    }
+    return events;
+}
+
+// Summable backtest outcome. equity is cash plus positions marked at the
+// last mid of each pair.
+struct BacktestResult {
+    std::uint64_t events = 0;
+    std::uint64_t orders = 0;
+    std::uint64_t fills = 0;
+    Size volume = 0;
+    double equity = 0;
+
+    BacktestResult& operator+=(const BacktestResult& other) noexcept {
+        events += other.events;
+        orders += other.orders;
+        fills += other.fills;
+        volume += other.volume;
+        equity += other.equity;
+        return *this;
+    }
+};
+
+// Venue stand-in for replay. Orders are matched against the latest recorded
+// quote: an order at or through the touch fills up to the touch size at the
+// touch price, and our fills use up that size until the next quote. IOC
+// remainders terminate; GTC remainders rest and fill at their limit when a
+// later quote crosses them. Callbacks are delivered inline, ack first, as a
+// fast venue would.
+class SimulatedExchange : public OrderSender {
+public:
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        const OrderId id = nextId_++;
+        ++result_.orders;
+        observer.onAck(id);
+        Quote& quote = quotes_[pair];
+        const bool buy = side == Side::Buy;
+        const Price touch = buy ? quote.askPrice : quote.bidPrice;
+        Size& available = buy ? quote.askSize : quote.bidSize;
+        if (available > 0 && (buy ? price >= touch : price <= touch)) {
+            const Size filled = std::min(size, available);
+            available -= filled;
+            size -= filled;
+            fill(pair, side, touch, filled, id, observer);
+        }
+        if (size > 0 && tif == Tif::GTC) {
+            resting_.push_back({id, pair, side, price, size, &observer});
+        } else {
+            observer.onTerminated(id);
+        }
+        return id;
+    }
+
+    void onEvent(const FeedEvent& event) {
+        ++result_.events;
+        const Event* e = std::get_if<Event>(&event);
+        if (e == nullptr) return;
+        Quote& quote = quotes_[e->pair];
+        quote = {e->bidPrice, e->bidSize, e->askPrice, e->askSize};
+        // Callbacks may send orders, which can grow resting_: work on a copy.
+        for (std::size_t i = 0; i < resting_.size();) {
+            Resting order = resting_[i];
+            const bool buy = order.side == Side::Buy;
+            Size& available = buy ? quote.askSize : quote.bidSize;
+            const bool crossed = order.pair == e->pair && available > 0 &&
+                                 (buy ? quote.askPrice <= order.price : quote.bidPrice >= order.price);
+            if (!crossed) {
+                ++i;
+                continue;
+            }
+            const Size filled = std::min(order.size, available);
+            available -= filled;
+            order.size -= filled;
+            if (order.size > 0) {
+                resting_[i++].size = order.size;
+            } else {
+                resting_[i] = resting_.back();
+                resting_.pop_back();
+            }
+            fill(order.pair, order.side, order.price, filled, order.id, *order.observer);
+            if (order.size == 0) order.observer->onTerminated(order.id);
+        }
+    }
+
+    // Counters since construction, with equity marked at the current quotes.
+    BacktestResult result() const noexcept {
+        BacktestResult result = result_;
+        result.equity = cash_;
+        for (PairId pair = 0; pair < kMaxPairs; ++pair) {
+            const Quote& q = quotes_[pair];
+            result.equity += static_cast<double>(positions_[pair]) * (q.bidPrice + q.askPrice) / 2;
+        }
+        return result;
+    }
+
+private:
+    struct Quote {
+        Price bidPrice;
+        Size bidSize;
+        Price askPrice;
+        Size askSize;
+    };
+
+    struct Resting {
+        OrderId id;
+        PairId pair;
+        Side side;
+        Price price;
+        Size size;
+        OrderStateObserver* observer;
+    };
+
+    void fill(PairId pair, Side side, Price price, Size size, OrderId id,
+              OrderStateObserver& observer) {
+        const Size signedSize = side == Side::Buy ? size : -size;
+        positions_[pair] += signedSize;
+        cash_ -= static_cast<double>(signedSize) * price;
+        ++result_.fills;
+        result_.volume += size;
+        observer.onFill(id, price, size);
+    }
+
+    OrderId nextId_ = 1;
+    Quote quotes_[kMaxPairs]{};
+    Size positions_[kMaxPairs]{};
+    double cash_ = 0;
+    std::vector<Resting> resting_;
+    BacktestResult result_;
+};
+
+// Builds the strategy for one shard (or for the whole run when state is
+// carried across shards). The strategy must send through |sender|.
+using StrategyFactory = std::function<std::unique_ptr<Strategy>(OrderSender& sender, std::size_t shard)>;
+
+inline void replayShard(const std::vector<FeedEvent>& events, SimulatedExchange& exchange,
+                        Strategy& strategy) {
+    for (const FeedEvent& event : events) {
+        exchange.onEvent(event);
+        deliver(strategy, event);
+    }
+}
+
+// Replays every shard independently on up to |threads| worker threads, each
+// with a fresh strategy and exchange. Shards are handed out from a shared
+// counter so uneven days balance out. Returns one result per shard, in
+// |paths| order; the first worker exception is rethrown after all join.
+inline std::vector<BacktestResult> runSharded(const std::vector<std::string>& paths,
+                                              const StrategyFactory& factory,
+                                              unsigned threads = std::thread::hardware_concurrency()) {
+    std::vector<BacktestResult> results(paths.size());
+    std::vector<std::exception_ptr> errors(paths.size());
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        for (std::size_t shard; (shard = next.fetch_add(1, std::memory_order_relaxed)) < paths.size();) {
+            try {
+                const std::vector<FeedEvent> events = loadTickFile(paths[shard]);
+                SimulatedExchange exchange;
+                const std::unique_ptr<Strategy> strategy = factory(exchange, shard);
+                replayShard(events, exchange, *strategy);
+                results[shard] = exchange.result();
+            } catch (...) {
+                errors[shard] = std::current_exception();
+            }
+        }
+    };
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(paths.size())));
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; ++i) workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers) worker.join();
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return results;
+}
+
+// Replays shards in order through one strategy and exchange, so positions,
+// resting orders and strategy state carry across day boundaries. The next
+// shard is loaded on another thread while the current one replays.
+inline BacktestResult runSequential(const std::vector<std::string>& paths, const StrategyFactory& factory) {
+    SimulatedExchange exchange;
+    const std::unique_ptr<Strategy> strategy = factory(exchange, 0);
+    std::future<std::vector<FeedEvent>> pending;
+    if (!paths.empty()) pending = std::async(std::launch::async, loadTickFile, paths[0]);
+    for (std::size_t shard = 0; shard < paths.size(); ++shard) {
+        const std::vector<FeedEvent> events = pending.get();
+        if (shard + 1 < paths.size()) {
+            pending = std::async(std::launch::async, loadTickFile, paths[shard + 1]);
+        }
+        replayShard(events, exchange, *strategy);
+    }
+    return exchange.result();
+}
+
+}  // namespace gts
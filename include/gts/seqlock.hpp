@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gts {
+
+// Single-writer sequence lock. The value is kept in atomic words so readers
+// on other threads never race with the writer; load() retries until it sees
+// a consistent copy.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock values must be trivially copyable");
+
+public:
+    void store(const T& value) noexcept {
+        std::uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const noexcept {
+        std::uint64_t words[kWords];
+        std::uint64_t seq;
+        do {
+            seq = seq_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) != 0 || seq != seq_.load(std::memory_order_relaxed));
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + 7) / 8;
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[kWords] = {};
+};
+
+}  // namespace gts
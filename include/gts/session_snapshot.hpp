@@ -0,0 +1,262 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/order_state_machine.hpp"
+#include "gts/position_engine.hpp"
+#include "gts/spot_limit.hpp"
+
+namespace gts {
+
+// Everything needed to resume a session: open orders, positions, spot limit
+// utilisation and the strategy's own trivially copyable state.
+template <typename StrategyState>
+struct SessionImage {
+    static constexpr std::size_t kMaxOrders = 4096;
+
+    Timestamp written;
+    Size spotUsed;
+    OrderId lastOrderId;
+    std::uint32_t orderCount;
+    SnapshotOrder orders[kMaxOrders];
+    PositionSnapshot positions[kMaxPairs];
+    StrategyState strategy;
+
+    bool addOrder(const SnapshotOrder& order) noexcept {
+        if (orderCount == kMaxOrders) {
+            return false;
+        }
+        orders[orderCount++] = order;
+        return true;
+    }
+
+    // Captures positions, spot limit use and the open order table. Returns
+    // false if there were more open orders than kMaxOrders.
+    bool capture(const PositionEngine& engine, const SpotLimitSizer& sizer,
+                 OrderLifecycle& lifecycle) noexcept {
+        for (PairId pair = 0; pair < kMaxPairs; ++pair) {
+            positions[pair] = engine.snapshot(pair);
+        }
+        spotUsed = sizer.used();
+        lastOrderId = lifecycle.lastOrderId();
+        orderCount = 0;
+        bool complete = true;
+        lifecycle.forEachOrder([&](const SnapshotOrder& order) { complete &= addOrder(order); });
+        return complete;
+    }
+
+    // Rebuild the sender chain as it was before the restart, then pass its
+    // outermost sender as |chain|. Positions are reloaded, ID assignment
+    // resumes after lastOrderId, and every open order is re-registered down
+    // the chain with |observer| receiving its callbacks; the sizer counts
+    // their remaining size again. Returns false if the rebuilt spot limit
+    // use differs from spotUsed, e.g. when the sizer is not in |chain| or
+    // runs in a different mode.
+    bool restore(PositionEngine& engine, SpotLimitSizer& sizer, RestorableSender& chain,
+                 OrderStateObserver& observer) const {
+        return restoreEach(engine, sizer, chain, [&](const SnapshotOrder& order) {
+            chain.restoreOrder(order, observer);
+        });
+    }
+
+    // As restore(), for a chain whose outermost sender needs more than an
+    // observer to re-register an order, such as a TaggedOrderSender and the
+    // order's tag: |restoreOrder| is called with every open order in turn.
+    template <typename Chain, typename RestoreOrder>
+    bool restoreEach(PositionEngine& engine, SpotLimitSizer& sizer, Chain& chain,
+                     RestoreOrder&& restoreOrder) const {
+        for (PairId pair = 0; pair < kMaxPairs; ++pair) {
+            engine.restore(pair, positions[pair]);
+            sizer.restorePosition(pair, positions[pair].ccy1Position);
+        }
+        chain.reserveOrderIds(lastOrderId);
+        for (std::uint32_t i = 0; i < orderCount; ++i) {
+            restoreOrder(orders[i]);
+        }
+        return sizer.used() == spotUsed;
+    }
+};
+
+// Memory-mapped, double-buffered session snapshot. The caller fills
+// staging() in place and commit() publishes it by flipping the active slot,
+// so a crash mid-write leaves the previous snapshot intact. On restart
+// latest() points straight into the mapping: recovery is one mmap.
+template <typename StrategyState>
+class SnapshotFile {
+    static_assert(std::is_trivially_copyable_v<StrategyState>,
+                  "strategy state must be trivially copyable to live in the snapshot");
+
+public:
+    using Image = SessionImage<StrategyState>;
+
+    explicit SnapshotFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        // Mapping past the end of a short file would fault on first access,
+        // so anything shorter than the layout is grown before mapping.
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "fstat " + path);
+        }
+        const bool fresh = st.st_size < static_cast<off_t>(sizeof(Layout));
+        if (fresh && ::ftruncate(fd, sizeof(Layout)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "ftruncate " + path);
+        }
+        void* data = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::system_error(err, std::generic_category(), "mmap " + path);
+        }
+        layout_ = static_cast<Layout*>(data);
+        if (fresh || layout_->magic != kMagic || layout_->layoutSize != sizeof(Layout)) {
+            // New file or a different build's layout: start empty.
+            layout_->active.store(kNoSnapshot, std::memory_order_relaxed);
+            layout_->layoutSize = sizeof(Layout);
+            layout_->magic = kMagic;
+        }
+    }
+
+    ~SnapshotFile() { ::munmap(layout_, sizeof(Layout)); }
+
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    // The last committed snapshot, or nullptr if there is none.
+    const Image* latest() const noexcept {
+        const std::uint32_t active = layout_->active.load(std::memory_order_acquire);
+        return active == kNoSnapshot ? nullptr : &layout_->slots[active];
+    }
+
+    // The inactive slot, cleared of orders, for the next snapshot.
+    Image& staging() noexcept {
+        Image& image = layout_->slots[stagingIndex()];
+        image.orderCount = 0;
+        return image;
+    }
+
+    // Publishes staging(). With |sync| the pages are also flushed to disk
+    // before returning; otherwise the kernel writes them back on its own,
+    // which survives a process crash but not a machine crash. The staged slot
+    // is flushed before the active index is flipped and flushed, so a
+    // machine crash cannot leave a committed index pointing at a torn slot.
+    void commit(bool sync = false) {
+        const std::uint32_t index = stagingIndex();
+        Image& image = layout_->slots[index];
+        image.written = nowNanos();
+        if (sync) {
+            syncRange(&image, sizeof(Image));
+        }
+        layout_->active.store(index, std::memory_order_release);
+        if (sync) {
+            syncRange(&layout_->active, sizeof(layout_->active));
+        }
+    }
+
+private:
+    static constexpr std::uint64_t kMagic = 0x475453534e415053ull;  // "GTSSNAPS"
+    static constexpr std::uint32_t kNoSnapshot = ~std::uint32_t{0};
+
+    struct Layout {
+        std::uint64_t magic;
+        std::uint64_t layoutSize;
+        std::atomic<std::uint32_t> active;
+        Image slots[2];
+    };
+
+    // msync() wants a page-aligned start.
+    static void syncRange(const void* data, std::size_t size) {
+        const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = reinterpret_cast<std::uintptr_t>(data) & ~(page - 1);
+        const auto end = reinterpret_cast<std::uintptr_t>(data) + size;
+        if (::msync(reinterpret_cast<void*>(begin), end - begin, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    std::uint32_t stagingIndex() const noexcept {
+        return layout_->active.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+    }
+
+    Layout* layout_;
+};
+
+// Writes a session snapshot every |interval|. The engine, sizer and lifecycle
+// are not thread-safe, so capture runs on the strategy thread: call
+// maybeWrite() from the event loop, e.g. on idle polls. Between snapshots it
+// costs one clock read and one compare.
+template <typename StrategyState>
+class PeriodicSnapshotWriter {
+public:
+    PeriodicSnapshotWriter(SnapshotFile<StrategyState>& file, const PositionEngine& engine,
+                           const SpotLimitSizer& sizer, OrderLifecycle& lifecycle,
+                           const StrategyState& strategy, Timestamp interval, bool sync = false)
+        : file_(file),
+          engine_(engine),
+          sizer_(sizer),
+          lifecycle_(lifecycle),
+          strategy_(strategy),
+          interval_(interval),
+          sync_(sync) {}
+
+    // Writes a snapshot if |interval| has passed since the last attempt.
+    // Returns true if one was committed.
+    bool maybeWrite(Timestamp now = nowNanos()) {
+        if (now - lastWrite_ < interval_) {
+            return false;
+        }
+        return write(now);
+    }
+
+    // Captures and commits a snapshot now. A capture that does not hold every
+    // open order is not committed, so the previous snapshot stays latest, and
+    // false is returned.
+    bool write(Timestamp now = nowNanos()) {
+        lastWrite_ = now;
+        typename SnapshotFile<StrategyState>::Image& image = file_.staging();
+        if (!image.capture(engine_, sizer_, lifecycle_)) {
+            ++incomplete_;
+            return false;
+        }
+        image.strategy = strategy_;
+        file_.commit(sync_);
+        ++written_;
+        return true;
+    }
+
+    std::uint64_t written() const noexcept { return written_; }
+    std::uint64_t incomplete() const noexcept { return incomplete_; }
+
+private:
+    SnapshotFile<StrategyState>& file_;
+    const PositionEngine& engine_;
+    const SpotLimitSizer& sizer_;
+    OrderLifecycle& lifecycle_;
+    const StrategyState& strategy_;
+    Timestamp interval_;
+    bool sync_;
+    Timestamp lastWrite_ = 0;
+    std::uint64_t written_ = 0;
+    std::uint64_t incomplete_ = 0;
+};
+
+}  // namespace gts
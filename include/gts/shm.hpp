@@ -0,0 +1,90 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace gts {
+
+// Owning mapping of a POSIX shared memory object. The creator sizes and
+// unlinks the object; openers map whatever size it has.
+class SharedMemory {
+public:
+    static SharedMemory create(const std::string& name, std::size_t size) {
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "ftruncate " + name);
+        }
+        return SharedMemory(name, fd, size, true);
+    }
+
+    static SharedMemory open(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "fstat " + name);
+        }
+        return SharedMemory(name, fd, static_cast<std::size_t>(st.st_size), false);
+    }
+
+    SharedMemory(SharedMemory&& other) noexcept
+        : name_(std::move(other.name_)), data_(other.data_), size_(other.size_),
+          owner_(other.owner_) {
+        other.data_ = nullptr;
+        other.owner_ = false;
+    }
+
+    SharedMemory& operator=(SharedMemory&&) = delete;
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    ~SharedMemory() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        if (owner_) {
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    void* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    SharedMemory(std::string name, int fd, std::size_t size, bool owner)
+        : name_(std::move(name)), size_(size), owner_(owner) {
+        data_ = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            if (owner_) {
+                ::shm_unlink(name_.c_str());
+            }
+            throw std::system_error(err, std::generic_category(), "mmap " + name_);
+        }
+    }
+
+    std::string name_;
+    void* data_ = nullptr;
+    std::size_t size_;
+    bool owner_;
+};
+
+}  // namespace gts
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/feed_sequencer.hpp"
+#include "gts/order_map.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/profiler.hpp"
+#include "gts/wire.hpp"
+
+namespace gts {
+
+// Client side of the venue socket. Ticks read by poll() go to the strategy
+// through postEvent(); sendOrder() writes the order straight to the socket
+// and returns a session-assigned ID.
+class SocketSession : public OrderSender, public RestorableSender {
+public:
+    // Called for every ack with the echoed trigger tick timestamp and the
+    // venue's receive time, both on the venue clock.
+    using ReceiptHandler = std::function<void(Timestamp trigger, Timestamp venueReceived)>;
+
+    SocketSession(const std::string& host, std::uint16_t port) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "socket");
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+            ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            const int err = errno;
+            ::close(fd_);
+            throw std::system_error(err, std::generic_category(), "connect " + host);
+        }
+        const int one = 1;
+        ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        buffer_.resize(1 << 16);
+    }
+
+    ~SocketSession() override { ::close(fd_); }
+
+    SocketSession(const SocketSession&) = delete;
+    SocketSession& operator=(const SocketSession&) = delete;
+
+    void setReceiptHandler(ReceiptHandler handler) { receiptHandler_ = std::move(handler); }
+
+    // Routes ticks through |sequencer| for gap detection instead of calling
+    // postEvent() directly, and drives its timeouts from poll(). The sequencer
+    // delivers to its own strategy. The wire protocol has no snapshot
+    // message, so build it without a SnapshotRequest: a gap then marks every
+    // pair stale until its next quote rather than buffering.
+    void setSequencer(FeedSequencer* sequencer) noexcept { sequencer_ = sequencer; }
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        const OrderId id = nextId_;
+        if (observers_.insert(id, &observer) == nullptr) {
+            // No room to route its updates: do not send it.
+            return kInvalidOrderId;
+        }
+        ++nextId_;
+        wire::NewOrder msg{wire::header<wire::NewOrder>(wire::MsgType::NewOrder),
+                           id, lastTick_, price, size, pair, side, tif};
+        GTS_PROFILE_STAGE(WireWrite);
+        writeAll(&msg, sizeof(msg));
+        return id;
+    }
+
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        if (observers_.insert(order.id, &observer) == nullptr) {
+            throw std::length_error("SocketSession: too many open orders to restore");
+        }
+        reserveOrderIds(order.id);
+    }
+
+    // Client order IDs must not repeat within a venue session.
+    void reserveOrderIds(OrderId last) override { nextId_ = std::max(nextId_, last + 1); }
+
+    // Reads whatever is available without blocking and dispatches it.
+    // Returns false once the venue has closed the connection. Throws
+    // std::runtime_error on a frame whose length does not match its type,
+    // since the stream can no longer be parsed.
+    bool poll(Strategy& strategy) {
+        if (sequencer_ != nullptr) {
+            sequencer_->checkTimeouts(nowNanos());
+        }
+        ssize_t n;
+        {
+            // Only reads that return data count; empty polls are idle time.
+            GTS_PROFILE_STAGE_AS(readTimer, SocketRead);
+            n = ::recv(fd_, buffer_.data() + filled_, buffer_.size() - filled_, MSG_DONTWAIT);
+            if (n <= 0) {
+                GTS_PROFILE_DISCARD(readTimer);
+            }
+        }
+        if (n == 0) {
+            return false;
+        }
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return true;
+            }
+            throw std::system_error(errno, std::generic_category(), "recv");
+        }
+        filled_ += static_cast<std::size_t>(n);
+
+        std::size_t offset = 0;
+        while (filled_ - offset >= sizeof(wire::Header)) {
+            wire::Header header;
+            std::memcpy(&header, buffer_.data() + offset, sizeof(header));
+            if (header.length != wire::messageLength(header.type)) {
+                throw std::runtime_error("SocketSession: malformed frame from venue");
+            }
+            if (filled_ - offset < header.length) {
+                break;
+            }
+            dispatch(header, buffer_.data() + offset, strategy);
+            offset += header.length;
+        }
+        std::memmove(buffer_.data(), buffer_.data() + offset, filled_ - offset);
+        filled_ -= offset;
+        return true;
+    }
+
+private:
+    void dispatch(const wire::Header& header, const char* data, Strategy& strategy) {
+        if (header.type == wire::MsgType::Tick) {
+            wire::Tick tick;
+            {
+                GTS_PROFILE_STAGE(Decode);
+                std::memcpy(&tick, data, sizeof(tick));
+                lastTick_ = tick.event.timestamp;
+            }
+            if (sequencer_ != nullptr) {
+                sequencer_->onTick(tick.sequence, tick.event);
+            } else {
+                strategy.postEvent(tick.event);
+            }
+            return;
+        }
+        wire::OrderUpdate update;
+        std::memcpy(&update, data, sizeof(update));
+        OrderStateObserver** observer = observers_.find(update.clientId);
+        if (observer == nullptr) {
+            return;
+        }
+        switch (header.type) {
+            case wire::MsgType::Ack:
+                if (receiptHandler_) {
+                    receiptHandler_(update.triggerTimestamp, update.venueReceived);
+                }
+                (*observer)->onAck(update.clientId);
+                break;
+            case wire::MsgType::Fill:
+                (*observer)->onFill(update.clientId, update.price, update.size);
+                break;
+            case wire::MsgType::Terminated: {
+                OrderStateObserver* target = *observer;
+                observers_.erase(update.clientId);
+                target->onTerminated(update.clientId);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void writeAll(const void* data, std::size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t n = ::send(fd_, p, size, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "send");
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    std::size_t filled_ = 0;
+    Timestamp lastTick_ = 0;
+    OrderId nextId_ = 1;
+    OrderMap<OrderStateObserver*> observers_;
+    ReceiptHandler receiptHandler_;
+    FeedSequencer* sequencer_ = nullptr;
+};
+
+}  // namespace gts
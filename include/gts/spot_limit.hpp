@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include "gts/api.hpp"
+#include "gts/order_registry.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/profiler.hpp"
+
+namespace gts {
+
+enum class SizingMode : std::uint8_t {
+    // Only filled positions count against the limit.
+    Filled,
+    // In-flight orders count as if they were fully filled.
+    Conservative,
+};
+
+// Tracks utilisation of the total spot limit, measured as the sum of absolute
+// CCY1 positions across pairs, and answers the largest size a new order may
+// have in O(1). Per-pair exposure and the running total are cached and only
+// refreshed from order callbacks.
+class SpotLimitSizer : public OrderSender, public RestorableSender, private OrderStateObserver {
+public:
+    SpotLimitSizer(OrderSender& inner, Size limit = kTotalSpotLimit,
+                   SizingMode mode = SizingMode::Conservative)
+        : inner_(inner), limit_(limit), mode_(mode) {}
+
+    // Largest order size on |pair| and |side| that keeps total exposure
+    // within the limit. Orders that reduce exposure stay allowed when the
+    // book is over the limit.
+    Size maxOrderSize(PairId pair, Side side) const noexcept {
+        const PairState& s = pairs_[pair];
+        const Size allowed = limit_ - (total_ - s.exposure);
+        const bool conservative = mode_ == SizingMode::Conservative;
+        const Size buyEdge = s.position + (conservative ? s.pendingBuy : 0);
+        const Size sellEdge = s.position - (conservative ? s.pendingSell : 0);
+        // Only the edge the order moves is checked: the other edge is not
+        // made worse, and refusing on it would lock out the very orders that
+        // bring an over-limit book back.
+        if (side == Side::Buy) {
+            return std::max<Size>(0, allowed - buyEdge);
+        }
+        return std::max<Size>(0, allowed + sellEdge);
+    }
+
+    Size used() const noexcept { return total_; }
+    Size limit() const noexcept { return limit_; }
+    Size position(PairId pair) const noexcept { return pairs_[pair].position; }
+
+    // Reinstates a filled position, e.g. after a restart. Orders still open
+    // at the venue come back through restoreOrder().
+    void restorePosition(PairId pair, Size position) noexcept {
+        PairState& s = pairs_[pair];
+        s.position = position;
+        refresh(s);
+    }
+
+    // Rejects with kInvalidOrderId when |size| exceeds maxOrderSize().
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        {
+            GTS_PROFILE_STAGE(RiskCheck);
+            if (size > maxOrderSize(pair, side) ||
+                !orders_.stage(OrderInfo{pair, side, size, &observer})) {
+                return kInvalidOrderId;
+            }
+            PairState& s = pairs_[pair];
+            (side == Side::Buy ? s.pendingBuy : s.pendingSell) += size;
+            refresh(s);
+        }
+
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, *this);
+        if (!orders_.commit(id)) {
+            // Refused further in: no callback will release the reservation.
+            PairState& s = pairs_[pair];
+            (side == Side::Buy ? s.pendingBuy : s.pendingSell) -= size;
+            refresh(s);
+            return kInvalidOrderId;
+        }
+        return id;
+    }
+
+    // Re-registers an order open at the venue. In Conservative mode its
+    // remaining size counts against the limit again.
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        orders_.insert(order.id, OrderInfo{order.pair, order.side, order.remaining, &observer});
+        PairState& s = pairs_[order.pair];
+        (order.side == Side::Buy ? s.pendingBuy : s.pendingSell) += order.remaining;
+        refresh(s);
+        restoreOrderIn(inner_, order, *this);
+    }
+
+    void reserveOrderIds(OrderId last) override { reserveOrderIdsIn(inner_, last); }
+
+private:
+    struct PairState {
+        Size position = 0;
+        Size pendingBuy = 0;
+        Size pendingSell = 0;
+        Size exposure = 0;
+    };
+
+    struct OrderInfo {
+        PairId pair;
+        Side side;
+        Size remaining;
+        OrderStateObserver* observer;
+    };
+
+    void refresh(PairState& s) noexcept {
+        Size exposure = std::llabs(s.position);
+        if (mode_ == SizingMode::Conservative) {
+            exposure = std::max(std::llabs(s.position + s.pendingBuy),
+                                std::llabs(s.position - s.pendingSell));
+        }
+        total_ += exposure - s.exposure;
+        s.exposure = exposure;
+    }
+
+    void onAck(OrderId id) override {
+        if (OrderInfo* info = orders_.ack(id)) {
+            info->observer->onAck(id);
+        }
+    }
+
+    void onFill(OrderId id, Price price, Size size) override {
+        if (OrderInfo* info = orders_.update(id)) {
+            PairState& s = pairs_[info->pair];
+            const Size filled = std::min(size, info->remaining);
+            info->remaining -= filled;
+            if (info->side == Side::Buy) {
+                s.pendingBuy -= filled;
+                s.position += size;
+            } else {
+                s.pendingSell -= filled;
+                s.position -= size;
+            }
+            refresh(s);
+            info->observer->onFill(id, price, size);
+        }
+    }
+
+    void onTerminated(OrderId id) override {
+        if (OrderInfo* info = orders_.update(id)) {
+            PairState& s = pairs_[info->pair];
+            (info->side == Side::Buy ? s.pendingBuy : s.pendingSell) -= info->remaining;
+            refresh(s);
+            OrderStateObserver* observer = info->observer;
+            orders_.erase(id);
+            observer->onTerminated(id);
+        }
+    }
+
+    OrderSender& inner_;
+    Size limit_;
+    SizingMode mode_;
+    Size total_ = 0;
+    std::array<PairState, kMaxPairs> pairs_{};
+    OrderRegistry<OrderInfo> orders_;
+};
+
+}  // namespace gts
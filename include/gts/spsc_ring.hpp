@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace gts {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+// Bounded single-producer/single-consumer ring. Storage is inline so the ring
+// can be placed in any memory region, including a shared mapping.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SpscRing elements must be trivially copyable");
+
+public:
+    // Producer side. Returns false when the ring is full.
+    bool tryPush(const T& value) noexcept {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ == Capacity) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ == Capacity) {
+                return false;
+            }
+        }
+        slots_[head & (Capacity - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the ring is empty.
+    bool tryPop(T& value) noexcept {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return false;
+            }
+        }
+        value = slots_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+private:
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t cachedTail_ = 0;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> tail_{0};
+    std::uint64_t cachedHead_ = 0;
+    alignas(kCacheLineSize) T slots_[Capacity];
+};
+
+}  // namespace gts
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "gts/api.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/spsc_ring.hpp"
+
+namespace gts {
+
+// Observer that receives the strategy's own context (ladder level, signal ID,
+// ...) with every callback.
+template <typename Tag>
+class TaggedObserver {
+public:
+    virtual ~TaggedObserver() = default;
+
+    virtual void onAck(OrderId id, Tag& tag) = 0;
+    virtual void onFill(OrderId id, Price price, Size size, Tag& tag) = 0;
+    virtual void onTerminated(OrderId id, Tag& tag) = 0;
+};
+
+// Sends orders with a user tag attached. Each live order owns a cache-line
+// sized slot from a fixed pool, and the slot itself is the observer handed to
+// the venue, so a callback reaches its tag through the object it is invoked
+// on: no ID lookup, no hashing. Slots return to the pool on onTerminated.
+// Order state is left to an OrderLifecycle further down the chain.
+template <typename Tag, std::size_t Capacity = 4096>
+class TaggedOrderSender {
+    static_assert(std::is_trivially_copyable_v<Tag>, "tags must be trivially copyable");
+    static_assert(sizeof(Tag) <= 40, "tags must fit in the order's cache line");
+
+public:
+    explicit TaggedOrderSender(OrderSender& inner) : inner_(inner), slots_(new Slot[Capacity]) {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots_[i].owner = this;
+            slots_[i].nextFree = i + 1 < Capacity ? &slots_[i + 1] : nullptr;
+        }
+        free_ = &slots_[0];
+    }
+
+    TaggedOrderSender(const TaggedOrderSender&) = delete;
+    TaggedOrderSender& operator=(const TaggedOrderSender&) = delete;
+
+    // Returns kInvalidOrderId when every slot is in use or the inner sender
+    // refuses the order.
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      TaggedObserver<Tag>& observer, const Tag& tag) {
+        Slot* slot = free_;
+        if (slot == nullptr) {
+            return kInvalidOrderId;
+        }
+        free_ = slot->nextFree;
+        slot->observer = &observer;
+        slot->tag = tag;
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, *slot);
+        if (id == kInvalidOrderId) {
+            release(slot);
+        }
+        return id;
+    }
+
+    // Warm restart: re-registers an order that was open when the session
+    // snapshot was taken, with the tag the strategy kept for it, and passes
+    // it down the chain. Tags are not part of SnapshotOrder, so the strategy
+    // saves them in its own snapshot state. Throws std::length_error when
+    // every slot is in use.
+    void restoreOrder(const SnapshotOrder& order, TaggedObserver<Tag>& observer, const Tag& tag) {
+        Slot* slot = free_;
+        if (slot == nullptr) {
+            throw std::length_error("TaggedOrderSender: too many open orders to restore");
+        }
+        free_ = slot->nextFree;
+        slot->observer = &observer;
+        slot->tag = tag;
+        restoreOrderIn(inner_, order, *slot);
+    }
+
+    void reserveOrderIds(OrderId last) { reserveOrderIdsIn(inner_, last); }
+
+    std::size_t available() const noexcept {
+        std::size_t count = 0;
+        for (const Slot* s = free_; s != nullptr; s = s->nextFree) {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct alignas(kCacheLineSize) Slot final : OrderStateObserver {
+        TaggedOrderSender* owner;
+        // Live slots point at the observer, free ones at the next free slot.
+        union {
+            TaggedObserver<Tag>* observer;
+            Slot* nextFree;
+        };
+        Tag tag;
+
+        void onAck(OrderId id) override { observer->onAck(id, tag); }
+
+        void onFill(OrderId id, Price price, Size size) override {
+            observer->onFill(id, price, size, tag);
+        }
+
+        void onTerminated(OrderId id) override {
+            observer->onTerminated(id, tag);
+            owner->release(this);
+        }
+    };
+
+    static_assert(sizeof(Slot) == kCacheLineSize, "an order's slot must be one cache line");
+
+    void release(Slot* slot) noexcept {
+        slot->nextFree = free_;
+        free_ = slot;
+    }
+
+    OrderSender& inner_;
+    std::unique_ptr<Slot[]> slots_;
+    Slot* free_ = nullptr;
+};
+
+}  // namespace gts
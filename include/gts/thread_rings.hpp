@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gts {
+
+// One producer ring per thread for a single consumer such as TraceRecorder
+// or Logger. A thread finds its ring through a small thread-local cache keyed
+// on an owner ID that is never reused, so an owner allocated at a destroyed
+// owner's address can never be handed the old ring. A cache miss registers
+// under the mutex and reuses the thread's existing ring for this owner, so a
+// thread alternating between several owners does not allocate again. Slots
+// live as long as their owner, so the consumer walks them without the mutex
+// and a producer registering never waits behind the consumer's I/O.
+template <typename Ring>
+class ThreadRings {
+public:
+    struct Slot {
+        std::uint32_t index;
+        std::thread::id thread;
+        Ring ring;
+    };
+
+    ThreadRings() : owner_(nextOwner()) {}
+
+    ThreadRings(const ThreadRings&) = delete;
+    ThreadRings& operator=(const ThreadRings&) = delete;
+
+    Slot& local() {
+        for (const Cached& cached : cache()) {
+            if (cached.owner == owner_) {
+                return *cached.slot;
+            }
+        }
+        Slot* slot = find();
+        cache()[nextVictim()++ % kCacheSize] = {owner_, slot};
+        return *slot;
+    }
+
+    // Consumer side, one thread only: visits every slot registered so far.
+    // The mutex is held only to copy the slot list.
+    template <typename Visitor>
+    void forEach(Visitor&& visit) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            visiting_.clear();
+            for (const auto& slot : slots_) {
+                visiting_.push_back(slot.get());
+            }
+        }
+        for (Slot* slot : visiting_) {
+            visit(*slot);
+        }
+    }
+
+private:
+    static constexpr std::size_t kCacheSize = 4;
+
+    struct Cached {
+        std::uint64_t owner;
+        Slot* slot;
+    };
+
+    static std::uint64_t nextOwner() noexcept {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static Cached (&cache() noexcept)[kCacheSize] {
+        thread_local Cached cached[kCacheSize] = {};
+        return cached;
+    }
+
+    static std::size_t& nextVictim() noexcept {
+        thread_local std::size_t victim = 0;
+        return victim;
+    }
+
+    Slot* find() {
+        const std::thread::id self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& slot : slots_) {
+            if (slot->thread == self) {
+                return slot.get();
+            }
+        }
+        slots_.push_back(std::make_unique<Slot>());
+        Slot* slot = slots_.back().get();
+        slot->index = static_cast<std::uint32_t>(slots_.size() - 1);
+        slot->thread = self;
+        return slot;
+    }
+
+    const std::uint64_t owner_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<Slot*> visiting_;
+};
+
+}  // namespace gts
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/profiler.hpp"
+
+namespace gts {
+
+enum class MessageKind : std::uint8_t { New, Cancel };
+
+// Token bucket sized to the venue's message rate. Tokens are kept in units of
+// 1/1e9 of a message so refilling from nanosecond timestamps is integer-only.
+// New orders may not dip into the last |cancelReserve| tokens, which keeps
+// room for cancels when the bucket runs low. A zero rate is rejected: the
+// bucket would never refill.
+class Throttle {
+public:
+    Throttle(std::uint32_t messagesPerSecond, std::uint32_t burst,
+             std::uint32_t cancelReserve = 1, Timestamp now = nowNanos())
+        : rate_(messagesPerSecond),
+          capacity_(static_cast<std::int64_t>(burst) * kUnit),
+          reserve_(static_cast<std::int64_t>(std::min(cancelReserve, burst)) * kUnit),
+          tokens_(capacity_),
+          maxElapsed_(rate_ > 0 ? capacity_ / rate_ + 1 : 0),
+          last_(now) {
+        if (messagesPerSecond == 0) {
+            throw std::invalid_argument("Throttle: messagesPerSecond must be positive");
+        }
+    }
+
+    // Cheap "can I send" query; does not consume.
+    bool canSend(MessageKind kind, Timestamp now = nowNanos()) noexcept {
+        refill(now);
+        return tokens_ >= threshold(kind);
+    }
+
+    bool tryConsume(MessageKind kind, Timestamp now = nowNanos()) noexcept {
+        refill(now);
+        if (tokens_ < threshold(kind)) {
+            ++throttled_;
+            return false;
+        }
+        tokens_ -= kUnit;
+        return true;
+    }
+
+    // Returns a token taken for a message that was not sent after all.
+    void refund() noexcept { tokens_ = std::min(capacity_, tokens_ + kUnit); }
+
+    // Nanoseconds until a message of |kind| would be allowed.
+    Timestamp waitTime(MessageKind kind, Timestamp now = nowNanos()) noexcept {
+        refill(now);
+        const std::int64_t missing = threshold(kind) - tokens_;
+        return missing <= 0 ? 0 : (missing + rate_ - 1) / rate_;
+    }
+
+    std::uint64_t throttled() const noexcept { return throttled_; }
+
+private:
+    static constexpr std::int64_t kUnit = 1'000'000'000;
+
+    std::int64_t threshold(MessageKind kind) const noexcept {
+        return kind == MessageKind::Cancel ? kUnit : kUnit + reserve_;
+    }
+
+    void refill(Timestamp now) noexcept {
+        if (now > last_) {
+            // Anything past maxElapsed_ refills the bucket anyway; clamping
+            // first keeps long idle gaps from overflowing the product.
+            const std::int64_t elapsed = std::min<std::int64_t>(now - last_, maxElapsed_);
+            tokens_ = std::min(capacity_, tokens_ + elapsed * rate_);
+            last_ = now;
+        }
+    }
+
+    std::int64_t rate_;
+    std::int64_t capacity_;
+    std::int64_t reserve_;
+    std::int64_t tokens_;
+    // Nanoseconds to refill from empty.
+    std::int64_t maxElapsed_;
+    Timestamp last_;
+    std::uint64_t throttled_ = 0;
+};
+
+// OrderSender decorator that checks the throttle before every sendOrder and
+// returns kInvalidOrderId instead of sending when the venue rate would be
+// exceeded. Orders refused further in never reach the venue, so their token
+// is refunded.
+class ThrottledOrderSender : public ForwardingRestorableSender {
+public:
+    ThrottledOrderSender(OrderSender& inner, Throttle& throttle)
+        : ForwardingRestorableSender(inner), throttle_(throttle) {}
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        {
+            GTS_PROFILE_STAGE(RiskCheck);
+            if (!throttle_.tryConsume(MessageKind::New)) {
+                return kInvalidOrderId;
+            }
+        }
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, observer);
+        if (id == kInvalidOrderId) {
+            throttle_.refund();
+        }
+        return id;
+    }
+
+    bool canSend() noexcept { return throttle_.canSend(MessageKind::New); }
+
+private:
+    Throttle& throttle_;
+};
+
+}  // namespace gts
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+#include "gts/order_restore.hpp"
+#include "gts/spsc_ring.hpp"
+#include "gts/thread_rings.hpp"
+
+namespace gts {
+
+enum class TraceEventType : std::uint8_t { Send, Ack, Fill, Terminated };
+
+// One order lifecycle event as written to the binary log.
+struct TraceRecord {
+    Timestamp timestamp;
+    OrderId orderId;
+    Price price;
+    Size size;
+    std::uint32_t threadId;
+    PairId pair;
+    TraceEventType type;
+    Side side;
+    Tif tif;
+    std::uint8_t reserved[7];
+};
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord layout is part of the file format");
+
+// Binary log file header, followed by a flat array of TraceRecord.
+struct TraceFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+constexpr char kTraceMagic[8] = {'G', 'T', 'S', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint32_t kTraceVersion = 1;
+
+// Collects TraceRecords from any number of threads into per-thread lock-free
+// rings and flushes them to |path| from a background thread. Recording never
+// waits on the flusher; when a ring is full the record is dropped and
+// counted. A thread's first record, and a ring cache miss on a thread that
+// records into more than a few recorders, briefly takes the ring registry
+// mutex, which is never held across file I/O.
+class TraceRecorder {
+public:
+    static constexpr std::size_t kRingCapacity = 1 << 16;
+
+    explicit TraceRecorder(const std::string& path)
+        : file_(std::fopen(path.c_str(), "wb")) {
+        if (file_ == nullptr) {
+            throw std::runtime_error("TraceRecorder: cannot open " + path);
+        }
+        TraceFileHeader header{};
+        std::copy(std::begin(kTraceMagic), std::end(kTraceMagic), header.magic);
+        header.version = kTraceVersion;
+        header.recordSize = sizeof(TraceRecord);
+        std::fwrite(&header, sizeof(header), 1, file_);
+        flusher_ = std::thread([this] { run(); });
+    }
+
+    ~TraceRecorder() {
+        running_.store(false, std::memory_order_release);
+        flusher_.join();
+        std::fclose(file_);
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    void record(Timestamp timestamp, TraceEventType type, OrderId id, PairId pair,
+                Side side, Tif tif, Price price, Size size) noexcept {
+        auto& slot = rings_.local();
+        TraceRecord rec{};
+        rec.timestamp = timestamp;
+        rec.orderId = id;
+        rec.price = price;
+        rec.size = size;
+        rec.threadId = slot.index;
+        rec.pair = pair;
+        rec.type = type;
+        rec.side = side;
+        rec.tif = tif;
+        if (!slot.ring.tryPush(rec)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void record(TraceEventType type, OrderId id, Price price = 0, Size size = 0) noexcept {
+        record(nowNanos(), type, id, 0, Side::Buy, Tif::GTC, price, size);
+    }
+
+    std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Ring = SpscRing<TraceRecord, kRingCapacity>;
+
+    // Returns the number of records written.
+    std::size_t drain() {
+        std::size_t total = 0;
+        std::size_t buffered = 0;
+        rings_.forEach([&](auto& slot) {
+            TraceRecord rec;
+            while (slot.ring.tryPop(rec)) {
+                buffer_[buffered++] = rec;
+                if (buffered == buffer_.size()) {
+                    std::fwrite(buffer_.data(), sizeof(TraceRecord), buffered, file_);
+                    total += buffered;
+                    buffered = 0;
+                }
+            }
+        });
+        if (buffered > 0) {
+            std::fwrite(buffer_.data(), sizeof(TraceRecord), buffered, file_);
+            total += buffered;
+        }
+        return total;
+    }
+
+    void run() {
+        buffer_.resize(4096);
+        while (running_.load(std::memory_order_acquire)) {
+            if (drain() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        drain();
+        std::fflush(file_);
+    }
+
+    std::FILE* file_;
+    ThreadRings<Ring> rings_;
+    std::vector<TraceRecord> buffer_;
+    std::atomic<bool> running_{true};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::thread flusher_;
+};
+
+// OrderSender decorator that records every accepted sendOrder with its
+// departure time. The timestamp is taken before the call since venues may
+// call back inline. Refused sends have no order to attach the record to.
+class TracingOrderSender : public ForwardingRestorableSender {
+public:
+    TracingOrderSender(OrderSender& inner, TraceRecorder& recorder)
+        : ForwardingRestorableSender(inner), recorder_(recorder) {}
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        const Timestamp sent = nowNanos();
+        const OrderId id = inner_.sendOrder(pair, side, price, size, tif, observer);
+        if (id != kInvalidOrderId) {
+            recorder_.record(sent, TraceEventType::Send, id, pair, side, tif, price, size);
+        }
+        return id;
+    }
+
+private:
+    TraceRecorder& recorder_;
+};
+
+// OrderStateObserver decorator that records every callback before forwarding.
+class TracingObserver : public OrderStateObserver {
+public:
+    TracingObserver(OrderStateObserver& inner, TraceRecorder& recorder)
+        : inner_(inner), recorder_(recorder) {}
+
+    void onAck(OrderId id) override {
+        recorder_.record(TraceEventType::Ack, id);
+        inner_.onAck(id);
+    }
+
+    void onFill(OrderId id, Price price, Size size) override {
+        recorder_.record(TraceEventType::Fill, id, price, size);
+        inner_.onFill(id, price, size);
+    }
+
+    void onTerminated(OrderId id) override {
+        recorder_.record(TraceEventType::Terminated, id);
+        inner_.onTerminated(id);
+    }
+
+private:
+    OrderStateObserver& inner_;
+    TraceRecorder& recorder_;
+};
+
+}  // namespace gts
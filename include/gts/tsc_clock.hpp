@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define GTS_HAS_TSC 1
+#else
+#define GTS_HAS_TSC 0
+#endif
+
+#include "gts/api.hpp"
+
+namespace gts {
+
+inline Timestamp realtimeNanos() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<Timestamp>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+// Nanosecond wall clock derived from the invariant TSC, calibrated against
+// CLOCK_REALTIME. Conversion parameters are published through a seqlock so
+// now() stays lock-free while recalibrate() slews them to correct drift.
+// Falls back to clock_gettime when the CPU lacks an invariant TSC.
+class TscClock {
+public:
+    static TscClock& instance() {
+        static TscClock clock;
+        return clock;
+    }
+
+    Timestamp now() const noexcept {
+        if (!usable_) {
+            return realtimeNanos();
+        }
+        return toNanos(readTsc());
+    }
+
+    // Converts a raw TSC reading to nanoseconds since the epoch.
+    Timestamp toNanos(std::uint64_t tsc) const noexcept {
+        std::uint64_t seq;
+        std::uint64_t baseTsc;
+        std::uint64_t mult;
+        Timestamp baseNs;
+        do {
+            seq = seq_.load(std::memory_order_acquire);
+            baseTsc = baseTsc_.load(std::memory_order_relaxed);
+            baseNs = baseNs_.load(std::memory_order_relaxed);
+            mult = mult_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) != 0 || seq != seq_.load(std::memory_order_relaxed));
+        const auto delta = static_cast<std::int64_t>(tsc - baseTsc);
+        const auto scaled = (static_cast<__int128>(delta) * mult) >> kShift;
+        return baseNs + static_cast<Timestamp>(scaled);
+    }
+
+    static std::uint64_t readTsc() noexcept {
+#if GTS_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    bool usable() const noexcept { return usable_; }
+
+    double ticksPerNano() const noexcept {
+        return static_cast<double>(std::uint64_t{1} << kShift) /
+               static_cast<double>(mult_.load(std::memory_order_relaxed));
+    }
+
+    // Re-anchors against CLOCK_REALTIME. The clock stays continuous: the
+    // measured offset is slewed out over |horizon| by adjusting the rate.
+    // Both the re-measured rate and the slew are capped at kMaxSlewRatio of
+    // the current rate, since the measurement includes any realtime step
+    // since the last anchor; a step is absorbed gradually, never as a jump or
+    // a burst of double-speed time. Call calibrate() to accept a step at once.
+    // Returns the offset (realtime - tsc clock) observed before correcting.
+    Timestamp recalibrate(std::chrono::nanoseconds horizon = std::chrono::seconds(1)) {
+        if (!usable_) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        std::uint64_t tsc = 0;
+        const Timestamp real = sample(tsc);
+        const Timestamp derived = toNanos(tsc);
+        const Timestamp offset = real - derived;
+
+        const std::uint64_t anchorTsc = baseTsc_.load(std::memory_order_relaxed);
+        const double current = static_cast<double>(mult_.load(std::memory_order_relaxed)) /
+                               static_cast<double>(std::uint64_t{1} << kShift);
+        double nanosPerTick = clampRatio(static_cast<double>(real - anchorReal_) /
+                                             static_cast<double>(tsc - anchorTsc),
+                                         current);
+        const double horizonNs = static_cast<double>(horizon.count());
+        const double slew = clampRatio(static_cast<double>(offset), 0, horizonNs);
+        nanosPerTick *= (horizonNs + slew) / horizonNs;
+
+        publish(tsc, derived, nanosPerTick);
+        anchorReal_ = real;
+        return offset;
+    }
+
+    // Measures the rate from scratch over 20 ms and re-anchors to realtime,
+    // jumping if needed. The constructor does this once, so the first now()
+    // blocks for 20 ms: call initClock() at startup, off the hot path.
+    void calibrate() {
+        if (!usable_) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        std::uint64_t tsc0 = 0;
+        std::uint64_t tsc1 = 0;
+        const Timestamp real0 = sample(tsc0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const Timestamp real1 = sample(tsc1);
+        const double nanosPerTick =
+            static_cast<double>(real1 - real0) / static_cast<double>(tsc1 - tsc0);
+        publish(tsc1, real1, nanosPerTick);
+        anchorReal_ = real1;
+    }
+
+private:
+    static constexpr int kShift = 32;
+    static constexpr double kMaxSlewRatio = 0.0005;
+
+    TscClock() {
+#if GTS_HAS_TSC
+        unsigned eax, ebx, ecx, edx;
+        usable_ = __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)) != 0;
+#endif
+        calibrate();
+    }
+
+    // Pairs a realtime reading with the TSC value at its midpoint, retrying
+    // to keep the bracket tight.
+    static Timestamp sample(std::uint64_t& tsc) noexcept {
+        std::uint64_t best = ~std::uint64_t{0};
+        Timestamp real = 0;
+        for (int i = 0; i < 8; ++i) {
+            const std::uint64_t before = readTsc();
+            const Timestamp ns = realtimeNanos();
+            const std::uint64_t after = readTsc();
+            if (after - before < best) {
+                best = after - before;
+                tsc = before + (after - before) / 2;
+                real = ns;
+            }
+        }
+        return real;
+    }
+
+    // Limits |value| to within kMaxSlewRatio of |scale| around |center|.
+    static double clampRatio(double value, double center, double scale) noexcept {
+        const double limit = scale * kMaxSlewRatio;
+        return std::min(std::max(value, center - limit), center + limit);
+    }
+
+    static double clampRatio(double value, double center) noexcept {
+        return clampRatio(value, center, center);
+    }
+
+    void publish(std::uint64_t tsc, Timestamp ns, double nanosPerTick) noexcept {
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        baseTsc_.store(tsc, std::memory_order_relaxed);
+        baseNs_.store(ns, std::memory_order_relaxed);
+        mult_.store(static_cast<std::uint64_t>(nanosPerTick * (std::uint64_t{1} << kShift)),
+                    std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    bool usable_ = false;
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> baseTsc_{0};
+    std::atomic<Timestamp> baseNs_{0};
+    std::atomic<std::uint64_t> mult_{std::uint64_t{1} << kShift};
+    std::mutex writerMutex_;
+    Timestamp anchorReal_ = 0;
+};
+
+// Runs TscClock::recalibrate() every |period| on a background thread.
+class TscDriftCorrector {
+public:
+    explicit TscDriftCorrector(std::chrono::milliseconds period = std::chrono::seconds(1))
+        : period_(period), worker_([this] { run(); }) {}
+
+    ~TscDriftCorrector() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        worker_.join();
+    }
+
+    TscDriftCorrector(const TscDriftCorrector&) = delete;
+    TscDriftCorrector& operator=(const TscDriftCorrector&) = delete;
+
+    Timestamp lastOffset() const noexcept {
+        return lastOffset_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!wakeup_.wait_for(lock, period_, [this] { return stopping_; })) {
+            lastOffset_.store(TscClock::instance().recalibrate(period_),
+                              std::memory_order_relaxed);
+        }
+    }
+
+    std::chrono::milliseconds period_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    std::atomic<Timestamp> lastOffset_{0};
+    std::thread worker_;
+};
+
+}  // namespace gts
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "gts/api.hpp"
+#include "gts/clock.hpp"
+
+namespace gts {
+
+enum class WaitState : std::uint8_t { Spin, Pause, Yield, Sleep, Count };
+
+struct WaitStats {
+    Timestamp nanos[static_cast<std::size_t>(WaitState::Count)];
+    std::uint64_t waits[static_cast<std::size_t>(WaitState::Count)];
+};
+
+// Event-loop idle policy that escalates spin -> _mm_pause -> sched_yield ->
+// sleep the longer the socket stays quiet. Thresholds follow an EWMA of the
+// observed tick inter-arrival time: in busy sessions the loop keeps spinning
+// across typical gaps, in quiet ones it backs off quickly and sleeps.
+class AdaptiveWaitPolicy {
+public:
+    struct Limits {
+        Timestamp minSpin = 2'000;
+        Timestamp maxSpin = 200'000;
+        Timestamp minSleep = 50'000;
+        Timestamp maxSleep = 1'000'000;
+    };
+
+    AdaptiveWaitPolicy() : AdaptiveWaitPolicy(Limits{}) {}
+
+    explicit AdaptiveWaitPolicy(const Limits& limits) : limits_(limits) { retune(); }
+
+    // Call whenever the poll produced work.
+    void onActivity(Timestamp now) noexcept {
+        if (lastActivity_ != 0) {
+            const Timestamp gap = now - lastActivity_;
+            // EWMA with weight 1/16 on the new sample.
+            gapEstimate_ += (gap - gapEstimate_) / 16;
+            retune();
+        }
+        lastActivity_ = now;
+        idleSince_ = 0;
+    }
+
+    // Call when a poll found nothing; waits according to how long the loop
+    // has been idle.
+    void idle(Timestamp now) {
+        if (idleSince_ == 0) {
+            idleSince_ = now;
+        }
+        const Timestamp idleFor = now - idleSince_;
+        WaitState state;
+        if (idleFor < spinFor_) {
+            state = WaitState::Spin;
+        } else if (idleFor < pauseUntil_) {
+            state = WaitState::Pause;
+            for (int i = 0; i < 16; ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+                _mm_pause();
+#endif
+            }
+        } else if (idleFor < yieldUntil_) {
+            state = WaitState::Yield;
+            sched_yield();
+        } else {
+            state = WaitState::Sleep;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(sleepFor_));
+        }
+        const auto index = static_cast<std::size_t>(state);
+        stats_.nanos[index] += nowNanos() - now;
+        ++stats_.waits[index];
+    }
+
+    const WaitStats& stats() const noexcept { return stats_; }
+    Timestamp gapEstimate() const noexcept { return gapEstimate_; }
+    Timestamp spinThreshold() const noexcept { return spinFor_; }
+
+    void report(std::FILE* out) const {
+        constexpr const char* kNames[] = {"spin", "pause", "yield", "sleep"};
+        std::fprintf(out, "wait policy: gap estimate %lld ns, spin %lld ns, sleep %lld ns\n",
+                     static_cast<long long>(gapEstimate_), static_cast<long long>(spinFor_),
+                     static_cast<long long>(sleepFor_));
+        for (std::size_t i = 0; i < static_cast<std::size_t>(WaitState::Count); ++i) {
+            std::fprintf(out, "  %-6s %14.3f ms %12llu waits\n", kNames[i],
+                         static_cast<double>(stats_.nanos[i]) / 1e6,
+                         static_cast<unsigned long long>(stats_.waits[i]));
+        }
+    }
+
+private:
+    void retune() noexcept {
+        // Spin across twice the typical gap when that is affordable; when
+        // gaps are longer than the spin budget, spinning rarely catches the
+        // next tick, so only spin briefly.
+        const Timestamp wanted = 2 * gapEstimate_;
+        spinFor_ = wanted <= limits_.maxSpin ? std::max(wanted, limits_.minSpin) : limits_.minSpin;
+        pauseUntil_ = spinFor_ * 4;
+        yieldUntil_ = pauseUntil_ * 4;
+        sleepFor_ = std::clamp(gapEstimate_ / 8, limits_.minSleep, limits_.maxSleep);
+    }
+
+    Limits limits_;
+    Timestamp gapEstimate_ = 0;
+    Timestamp lastActivity_ = 0;
+    Timestamp idleSince_ = 0;
+    Timestamp spinFor_ = 0;
+    Timestamp pauseUntil_ = 0;
+    Timestamp yieldUntil_ = 0;
+    Timestamp sleepFor_ = 0;
+    WaitStats stats_{};
+};
+
+// Drives |poll| until |running| clears. |poll| returns how much work it did;
+// idle iterations go through |policy|.
+template <typename Poll>
+void runEventLoop(Poll&& poll, AdaptiveWaitPolicy& policy, const std::atomic<bool>& running) {
+    while (running.load(std::memory_order_relaxed)) {
+        const auto work = poll();
+        const Timestamp now = nowNanos();
+        if (work > 0) {
+            policy.onActivity(now);
+        } else {
+            policy.idle(now);
+        }
+    }
+}
+
+}  // namespace gts
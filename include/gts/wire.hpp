@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "gts/api.hpp"
+
+namespace gts {
+namespace wire {
+
+// Binary protocol spoken over the venue socket. Messages are fixed-size
+// structs in host byte order, each starting with a Header whose length
+// covers the whole message.
+
+enum class MsgType : std::uint8_t { Tick = 1, NewOrder, Ack, Fill, Terminated };
+
+struct Header {
+    MsgType type;
+    std::uint8_t reserved[3];
+    std::uint32_t length;
+};
+
+// Event::timestamp is the venue's send time. Sequence numbers increase by
+// one per tick so receivers can detect gaps.
+struct Tick {
+    Header header;
+    std::uint64_t sequence;
+    Event event;
+};
+
+struct NewOrder {
+    Header header;
+    OrderId clientId;
+    // Timestamp of the last tick delivered before this order was sent, echoed
+    // back in the updates so the venue clock measures tick-to-order.
+    Timestamp triggerTimestamp;
+    Price price;
+    Size size;
+    PairId pair;
+    Side side;
+    Tif tif;
+};
+
+struct OrderUpdate {
+    Header header;
+    OrderId clientId;
+    Timestamp triggerTimestamp;
+    // When the venue read the order off the socket.
+    Timestamp venueReceived;
+    Price price;
+    Size size;
+};
+
+// The length a message of |type| must have; 0 for unknown types. Receivers
+// check every header against it before trusting the length.
+constexpr std::uint32_t messageLength(MsgType type) noexcept {
+    switch (type) {
+        case MsgType::Tick:
+            return sizeof(Tick);
+        case MsgType::NewOrder:
+            return sizeof(NewOrder);
+        case MsgType::Ack:
+        case MsgType::Fill:
+        case MsgType::Terminated:
+            return sizeof(OrderUpdate);
+    }
+    return 0;
+}
+
+template <typename Msg>
+constexpr Header header(MsgType type) {
+    static_assert(std::is_trivially_copyable_v<Msg>);
+    return Header{type, {}, static_cast<std::uint32_t>(sizeof(Msg))};
+}
+
+}  // namespace wire
+}  // namespace gts
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "gts/cross_rates.hpp"
+
+namespace {
+
+constexpr gts::PairId kEurUsd = 0;
+constexpr gts::PairId kUsdJpy = 1;
+constexpr gts::PairId kEurJpy = 2;
+constexpr gts::PairId kGbpChf = 3;
+
+gts::Event quote(gts::PairId pair, gts::Price bid, gts::Price ask, gts::Timestamp t = 1) {
+    return gts::Event{t, pair, bid, 1, ask, 1};
+}
+
+TEST(CrossRateEngine, CrossesThroughStraightAndInvertedLegs) {
+    gts::CrossRateEngine engine;
+    engine.addPair(kEurUsd, "EUR", "USD");
+    engine.addPair(kUsdJpy, "USD", "JPY");
+    engine.onEvent(quote(kEurUsd, 1.1, 1.2, 5));
+    engine.onEvent(quote(kUsdJpy, 150.0, 151.0, 7));
+
+    const int eurJpy = engine.findCross("EUR", "JPY");
+    ASSERT_GE(eurJpy, 0);
+    const gts::CrossRate& straight = engine.cross(eurJpy);
+    EXPECT_DOUBLE_EQ(straight.bid, 1.1 * 150.0);
+    EXPECT_DOUBLE_EQ(straight.ask, 1.2 * 151.0);
+    EXPECT_EQ(straight.updated, 7);
+    EXPECT_EQ(straight.direct, gts::kNoPair);
+
+    // JPY/EUR sells JPY for USD and USD for EUR, both against the quotes.
+    const int jpyEur = engine.findCross("JPY", "EUR");
+    ASSERT_GE(jpyEur, 0);
+    const gts::CrossRate& inverted = engine.cross(jpyEur);
+    EXPECT_DOUBLE_EQ(inverted.bid, (1 / 151.0) * (1 / 1.2));
+    EXPECT_DOUBLE_EQ(inverted.ask, (1 / 150.0) * (1 / 1.1));
+    EXPECT_LT(inverted.bid, inverted.ask);
+}
+
+TEST(CrossRateEngine, LinksDirectQuoteWhenRegisteredLater) {
+    gts::CrossRateEngine engine;
+    engine.addPair(kEurUsd, "EUR", "USD");
+    engine.addPair(kUsdJpy, "USD", "JPY");
+    EXPECT_EQ(engine.cross(engine.findCross("EUR", "JPY")).direct, gts::kNoPair);
+    engine.addPair(kEurJpy, "EUR", "JPY");
+    EXPECT_EQ(engine.cross(engine.findCross("EUR", "JPY")).direct, kEurJpy);
+    EXPECT_EQ(engine.cross(engine.findCross("JPY", "EUR")).direct, gts::kNoPair);
+}
+
+TEST(CrossRateEngine, RecomputesOnlyDependentCrosses) {
+    gts::CrossRateEngine engine;
+    engine.addPair(kEurUsd, "EUR", "USD");
+    engine.addPair(kUsdJpy, "USD", "JPY");
+    engine.addPair(kGbpChf, "GBP", "CHF");
+    std::vector<std::uint16_t> recomputed;
+    const auto collect = [&](std::uint16_t index) { recomputed.push_back(index); };
+
+    // One leg alone has no cross to report yet.
+    engine.onEvent(quote(kEurUsd, 1.1, 1.2), collect);
+    EXPECT_TRUE(recomputed.empty());
+    engine.onEvent(quote(kUsdJpy, 150.0, 151.0), collect);
+    EXPECT_EQ(recomputed.size(), 2u);
+
+    recomputed.clear();
+    engine.onEvent(quote(kGbpChf, 1.1, 1.2), collect);
+    EXPECT_TRUE(recomputed.empty());
+}
+
+TEST(CrossRateEngine, AddingPairTwiceIsIdempotent) {
+    gts::CrossRateEngine engine;
+    engine.addPair(kEurUsd, "EUR", "USD");
+    engine.addPair(kUsdJpy, "USD", "JPY");
+    const std::size_t crosses = engine.crossCount();
+    for (int i = 0; i < 40; ++i) engine.addPair(kUsdJpy, "USD", "JPY");
+    EXPECT_EQ(engine.crossCount(), crosses);
+
+    std::vector<std::uint16_t> recomputed;
+    engine.onEvent(quote(kEurUsd, 1.1, 1.2));
+    engine.onEvent(quote(kUsdJpy, 150.0, 151.0), [&](std::uint16_t i) { recomputed.push_back(i); });
+    EXPECT_EQ(recomputed.size(), 2u);
+
+    EXPECT_THROW(engine.addPair(kUsdJpy, "USD", "CHF"), std::invalid_argument);
+}
+
+TEST(CrossRateEngine, RejectsPairIdOutOfRange) {
+    gts::CrossRateEngine engine;
+    EXPECT_THROW(engine.addPair(gts::kMaxPairs, "EUR", "USD"), std::out_of_range);
+}
+
+}  // namespace
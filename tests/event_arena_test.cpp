@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <vector>
+
+#include "gts/event_arena.hpp"
+
+namespace {
+
+TEST(EventArena, ResetReusesTheBlock) {
+    gts::EventArena arena(4096);
+    void* first = arena.resource()->allocate(256, 8);
+    EXPECT_NE(arena.resource()->allocate(256, 8), nullptr);
+    arena.reset();
+    EXPECT_EQ(arena.resource()->allocate(256, 8), first);
+    EXPECT_EQ(arena.overflows(), 0u);
+    EXPECT_EQ(arena.capacity(), 4096u);
+}
+
+TEST(EventArena, CountsAllocationsBeyondTheBlock) {
+    gts::EventArena arena(1024);
+    EXPECT_NE(arena.resource()->allocate(512, 8), nullptr);
+    EXPECT_NE(arena.resource()->allocate(4096, 8), nullptr);
+    EXPECT_EQ(arena.overflows(), 1u);
+
+    // After a reset the block serves small requests again.
+    arena.reset();
+    EXPECT_NE(arena.resource()->allocate(512, 8), nullptr);
+    EXPECT_EQ(arena.overflows(), 1u);
+}
+
+class Building : public gts::Strategy {
+public:
+    explicit Building(gts::EventArena& arena) : arena_(arena) {}
+
+    void postEvent(const gts::Event& event) override {
+        std::pmr::vector<gts::Price> levels(arena_.resource());
+        for (int i = 0; i < 16; ++i) levels.push_back(event.bidPrice - i * 1e-5);
+        data = levels.data();
+    }
+
+    const gts::Price* data = nullptr;
+
+private:
+    gts::EventArena& arena_;
+};
+
+TEST(ArenaScopedStrategy, ResetsAfterEveryEvent) {
+    gts::EventArena arena(64 * 1024);
+    Building strategy(arena);
+    gts::ArenaScopedStrategy scoped(strategy, arena);
+    scoped.postEvent(gts::Event{1, 0, 1.1, 1, 1.2, 1});
+    const gts::Price* first = strategy.data;
+    for (int i = 0; i < 1000; ++i) {
+        scoped.postEvent(gts::Event{2, 0, 1.1, 1, 1.2, 1});
+        ASSERT_EQ(strategy.data, first);
+    }
+    EXPECT_EQ(arena.overflows(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "gts/fair_value.hpp"
+
+namespace {
+
+TEST(FairValueEngine, MicropriceLeansTowardsTheThinSide) {
+    gts::FairValueEngine engine;
+    engine.onEvent(gts::Event{1, 0, 1.0, 3, 1.2, 1});
+    const gts::FairValue& v = engine.value(0);
+    EXPECT_EQ(v.updated, 1);
+    EXPECT_EQ(v.mid, gts::toFixed(1.1));
+    EXPECT_EQ(v.microprice, gts::toFixed(1.15));
+    EXPECT_EQ(v.imbalance, gts::kFixedScale / 2);
+}
+
+TEST(FairValueEngine, OwnFillAggressorDependsOnTif) {
+    gts::FairValueEngine engine(6, 4);
+    // An IOC buy lifted the offer: buyers aggressed.
+    engine.onFill(0, gts::Side::Buy, gts::Tif::IOC, 1.1, 160);
+    EXPECT_EQ(engine.value(0).tradeFlow, 10);
+
+    // A resting GTC buy was hit: sellers aggressed.
+    engine.onFill(1, gts::Side::Buy, gts::Tif::GTC, 1.1, 160);
+    EXPECT_EQ(engine.value(1).tradeFlow, -10);
+    EXPECT_EQ(engine.value(1).lastTrade, gts::toFixed(1.1));
+}
+
+}  // namespace
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "gts/api.hpp"
+#include "gts/order_restore.hpp"
+
+namespace gts::test {
+
+// Scripted venue for decorator tests. Records every order and either refuses
+// it, answers inline (ack, optional full fill, optional termination), rejects
+// it inline with a termination and no ack, or leaves it open for the test to
+// drive through the recorded observer.
+// Restored orders are recorded like sent ones.
+class FakeSender : public OrderSender, public RestorableSender {
+public:
+    enum class Mode { Refuse, Open, AckInline, FillInline, RejectInline };
+
+    struct Order {
+        OrderId id;
+        PairId pair;
+        Side side;
+        Price price;
+        Size size;
+        Tif tif;
+        OrderStateObserver* observer;
+    };
+
+    OrderId sendOrder(PairId pair, Side side, Price price, Size size, Tif tif,
+                      OrderStateObserver& observer) override {
+        if (mode == Mode::Refuse) {
+            ++refused;
+            return kInvalidOrderId;
+        }
+        const OrderId id = nextId++;
+        orders.push_back({id, pair, side, price, size, tif, &observer});
+        if (mode == Mode::AckInline || mode == Mode::FillInline) observer.onAck(id);
+        if (mode == Mode::FillInline) {
+            observer.onFill(id, price, size);
+        }
+        if (mode == Mode::FillInline || mode == Mode::RejectInline) {
+            observer.onTerminated(id);
+        }
+        return id;
+    }
+
+    void restoreOrder(const SnapshotOrder& order, OrderStateObserver& observer) override {
+        orders.push_back({order.id, order.pair, order.side, order.price, order.remaining, order.tif, &observer});
+        reserveOrderIds(order.id);
+    }
+
+    void reserveOrderIds(OrderId last) override { nextId = std::max(nextId, last + 1); }
+
+    void ack(const Order& order) { order.observer->onAck(order.id); }
+    void fill(const Order& order, Size size) { order.observer->onFill(order.id, order.price, size); }
+    void terminate(const Order& order) { order.observer->onTerminated(order.id); }
+
+    Mode mode = Mode::Open;
+    OrderId nextId = 1;
+    int refused = 0;
+    std::vector<Order> orders;
+};
+
+// Observer that counts what reaches the strategy.
+struct CountingObserver : OrderStateObserver {
+    void onAck(OrderId) override { ++acks; }
+    void onFill(OrderId, Price, Size size) override { filled += size; ++fills; }
+    void onTerminated(OrderId) override { ++terminated; }
+
+    int acks = 0;
+    int fills = 0;
+    int terminated = 0;
+    Size filled = 0;
+};
+
+}  // namespace gts::test
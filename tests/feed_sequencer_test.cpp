@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "gts/feed_sequencer.hpp"
+
+namespace {
+
+class Recording : public gts::Strategy {
+public:
+    void postEvent(const gts::Event& event) override { seen.push_back(event.timestamp); }
+
+    std::vector<gts::Timestamp> seen;
+};
+
+// The venue timestamp doubles as an identifier for the tick.
+gts::Event tick(gts::PairId pair, gts::Timestamp id) { return gts::Event{id, pair, 1.0, 1, 1.1, 1}; }
+
+constexpr gts::Timestamp kStall = 1'000;
+constexpr gts::Timestamp kResync = 10'000;
+
+struct Fixture {
+    Recording strategy;
+    std::vector<std::uint64_t> requests;
+    gts::FeedSequencer sequencer{strategy, [this](std::uint64_t next) { requests.push_back(next); },
+                                 kStall, kResync};
+};
+
+TEST(FeedSequencer, DeliversInSequenceAndDropsDuplicates) {
+    Fixture f;
+    EXPECT_FALSE(f.sequencer.isFresh(0));
+    f.sequencer.onTick(1, tick(0, 1), 0);
+    f.sequencer.onTick(2, tick(0, 2), 0);
+    f.sequencer.onTick(2, tick(0, 2), 0);
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1, 2}));
+    EXPECT_EQ(f.sequencer.duplicates(), 1u);
+    EXPECT_TRUE(f.sequencer.isFresh(0));
+}
+
+TEST(FeedSequencer, GapBuffersUntilSnapshotThenReplaysNewerDeltas) {
+    Fixture f;
+    f.sequencer.onTick(1, tick(0, 1), 0);
+    f.sequencer.onTick(4, tick(0, 4), 0);
+    f.sequencer.onTick(5, tick(1, 5), 0);
+    EXPECT_TRUE(f.sequencer.resyncing());
+    EXPECT_EQ(f.requests, (std::vector<std::uint64_t>{2}));
+    EXPECT_FALSE(f.sequencer.isFresh(0));
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1}));
+
+    f.sequencer.onSnapshot(tick(0, 100));
+    f.sequencer.onSnapshotComplete(4);
+    EXPECT_FALSE(f.sequencer.resyncing());
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1, 100, 5}));
+    EXPECT_TRUE(f.sequencer.isFresh(0));
+    EXPECT_TRUE(f.sequencer.isFresh(1));
+    EXPECT_EQ(f.sequencer.gaps(), 1u);
+}
+
+TEST(FeedSequencer, OverdueSnapshotIsRequestedAgainThenAbandoned) {
+    Fixture f;
+    f.sequencer.onTick(1, tick(0, 1), 0);
+    f.sequencer.onTick(3, tick(0, 3), 0);
+    f.sequencer.onTick(4, tick(0, 4), 0);
+    ASSERT_EQ(f.requests.size(), 1u);
+
+    gts::Timestamp now = 0;
+    f.sequencer.checkTimeouts(now += kResync);
+    EXPECT_EQ(f.requests.size(), 1u);
+    for (unsigned i = 1; i < gts::FeedSequencer::kMaxSnapshotRequests; ++i) {
+        f.sequencer.checkTimeouts(now += kResync + 1);
+        EXPECT_EQ(f.requests.size(), i + 1);
+        EXPECT_EQ(f.requests.back(), 2u);
+        EXPECT_TRUE(f.sequencer.resyncing());
+    }
+
+    f.sequencer.checkTimeouts(now += kResync + 1);
+    EXPECT_FALSE(f.sequencer.resyncing());
+    EXPECT_EQ(f.sequencer.abandonedResyncs(), 1u);
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1, 3, 4}));
+    EXPECT_TRUE(f.sequencer.isFresh(0));
+
+    f.sequencer.onTick(5, tick(0, 5), now);
+    EXPECT_EQ(f.strategy.seen.back(), 5);
+    EXPECT_EQ(f.sequencer.gaps(), 1u);
+}
+
+TEST(FeedSequencer, SnapshotOutsideResyncIsIgnored) {
+    Fixture f;
+    f.sequencer.onTick(1, tick(0, 1), 0);
+    f.sequencer.onTick(2, tick(0, 2), 0);
+
+    // A late snapshot must neither reach the strategy nor rewind the
+    // expected sequence.
+    f.sequencer.onSnapshot(tick(0, 100));
+    f.sequencer.onSnapshotComplete(1);
+    EXPECT_FALSE(f.sequencer.resyncing());
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1, 2}));
+
+    f.sequencer.onTick(2, tick(0, 2), 0);
+    f.sequencer.onTick(3, tick(0, 3), 0);
+    EXPECT_EQ(f.strategy.seen, (std::vector<gts::Timestamp>{1, 2, 3}));
+    EXPECT_EQ(f.sequencer.duplicates(), 1u);
+    EXPECT_TRUE(f.requests.empty());
+}
+
+TEST(FeedSequencer, WithoutSnapshotSourceGapOnlyMarksPairsStale) {
+    Recording strategy;
+    gts::FeedSequencer sequencer(strategy);
+    sequencer.onTick(1, tick(0, 1), 0);
+    sequencer.onTick(2, tick(1, 2), 0);
+    sequencer.onTick(5, tick(0, 5), 0);
+    EXPECT_FALSE(sequencer.resyncing());
+    EXPECT_EQ(sequencer.gaps(), 1u);
+    EXPECT_EQ(strategy.seen, (std::vector<gts::Timestamp>{1, 2, 5}));
+    EXPECT_TRUE(sequencer.isFresh(0));
+    EXPECT_FALSE(sequencer.isFresh(1));
+    sequencer.onTick(6, tick(1, 6), 0);
+    EXPECT_TRUE(sequencer.isFresh(1));
+}
+
+TEST(FeedSequencer, StallIsMeasuredFromLocalReceiveTime) {
+    Fixture f;
+    // Venue timestamps far behind the local clock must not look like a stall.
+    const gts::Timestamp received = 1'000'000'000;
+    f.sequencer.onTick(1, tick(0, 1), received);
+    f.sequencer.checkTimeouts(received + kStall);
+    EXPECT_EQ(f.sequencer.stalls(), 0u);
+    EXPECT_TRUE(f.sequencer.isFresh(0));
+    f.sequencer.checkTimeouts(received + kStall + 1);
+    EXPECT_EQ(f.sequencer.stalls(), 1u);
+    EXPECT_FALSE(f.sequencer.isFresh(0));
+}
+
+}  // namespace
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "gts/logger.hpp"
+
+namespace {
+
+std::string readAll(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+TEST(Logger, FormatsPlaceholders) {
+    const std::string path = ::testing::TempDir() + "logger_format.log";
+    {
+        gts::Logger logger(path);
+        logger.info("order {} {} at {} ok={}", 42, 'B', 1.5, true);
+        logger.debug("filtered {}", 1);
+    }
+    const std::string text = readAll(path);
+    EXPECT_NE(text.find("INFO  order 42 B at 1.5 ok=true"), std::string::npos);
+    EXPECT_EQ(text.find("filtered"), std::string::npos);
+}
+
+TEST(Logger, ReplacementAtSameAddressStartsClean) {
+    const std::string first = ::testing::TempDir() + "logger_first.log";
+    const std::string second = ::testing::TempDir() + "logger_second.log";
+    alignas(gts::Logger) unsigned char storage[sizeof(gts::Logger)];
+    auto* logger = new (storage) gts::Logger(first);
+    logger->info("first");
+    logger->~Logger();
+    logger = new (storage) gts::Logger(second);
+    logger->info("second");
+    logger->~Logger();
+    EXPECT_EQ(readAll(second).find("first"), std::string::npos);
+    EXPECT_NE(readAll(second).find("second"), std::string::npos);
+}
+
+}  // namespace
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <string>
+
+#include "gts/market_data_bus.hpp"
+
+namespace {
+
+std::string busName(const char* name) {
+    return std::string("/gts_test_") + name + "_" + std::to_string(::getpid());
+}
+
+gts::Event quote(gts::Timestamp timestamp) {
+    return gts::Event{timestamp, 1, 1.1, 100, 1.2, 100};
+}
+
+TEST(MarketDataBus, DeliversInOrder) {
+    const std::string name = busName("order");
+    gts::MarketDataPublisher publisher(name, 8);
+    gts::MarketDataSubscriber subscriber(name);
+    for (gts::Timestamp t = 1; t <= 5; ++t) publisher.publish(quote(t));
+    gts::FeedEvent event;
+    for (gts::Timestamp t = 1; t <= 5; ++t) {
+        ASSERT_TRUE(subscriber.poll(event));
+        EXPECT_EQ(gts::timestampOf(event), t);
+    }
+    EXPECT_FALSE(subscriber.poll(event));
+    EXPECT_EQ(subscriber.overruns(), 0u);
+}
+
+// Publishers and subscribers built before DepthUpdate existed share the bus
+// with newer ones, so the original alternatives keep their indices.
+TEST(MarketDataBus, FeedEventIndicesAreStable) {
+    EXPECT_EQ(gts::FeedEvent(gts::Event{}).index(), 0u);
+    EXPECT_EQ(gts::FeedEvent(gts::Trade{}).index(), 1u);
+    EXPECT_EQ(gts::FeedEvent(gts::SessionStatus{}).index(), 2u);
+    EXPECT_EQ(gts::FeedEvent(gts::Heartbeat{}).index(), 3u);
+    EXPECT_EQ(gts::FeedEvent(gts::DepthUpdate{}).index(), 4u);
+}
+
+TEST(MarketDataBus, LappedReaderSkipsToOldestIntact) {
+    const std::string name = busName("lapped");
+    gts::MarketDataPublisher publisher(name, 8);
+    gts::MarketDataSubscriber subscriber(name);
+    for (gts::Timestamp t = 1; t <= 20; ++t) publisher.publish(quote(t));
+    gts::FeedEvent event;
+    ASSERT_TRUE(subscriber.poll(event));
+    const gts::Timestamp first = gts::timestampOf(event);
+    EXPECT_GT(first, 12);
+    EXPECT_EQ(subscriber.overruns(), static_cast<std::uint64_t>(first - 1));
+    gts::Timestamp last = first;
+    while (subscriber.poll(event)) last = gts::timestampOf(event);
+    EXPECT_EQ(last, 20);
+}
+
+}  // namespace
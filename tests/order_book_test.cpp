@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gts/order_book.hpp"
+
+namespace {
+
+using Book = gts::OrderBook<4>;
+
+std::vector<gts::Fixed> prices(const Book& book, gts::Side side) {
+    std::vector<gts::Fixed> out;
+    for (std::size_t i = 0; i < book.depth(side); ++i) {
+        out.push_back(book.level(side, i).price);
+    }
+    return out;
+}
+
+TEST(OrderBook, InsertsShiftWorseLevelsBackAndDropPastDepth) {
+    Book book;
+    book.update(gts::Side::Buy, 100, 1);
+    book.update(gts::Side::Buy, 98, 1);
+    book.update(gts::Side::Buy, 99, 1);
+    book.update(gts::Side::Buy, 101, 1);
+    EXPECT_EQ(prices(book, gts::Side::Buy), (std::vector<gts::Fixed>{101, 100, 99, 98}));
+
+    // Full: a better level pushes the worst one out, a worse one is ignored.
+    book.update(gts::Side::Buy, 102, 1);
+    EXPECT_EQ(prices(book, gts::Side::Buy), (std::vector<gts::Fixed>{102, 101, 100, 99}));
+    book.update(gts::Side::Buy, 97, 1);
+    EXPECT_EQ(prices(book, gts::Side::Buy), (std::vector<gts::Fixed>{102, 101, 100, 99}));
+
+    // Asks sort the other way.
+    book.update(gts::Side::Sell, 105, 1);
+    book.update(gts::Side::Sell, 103, 2);
+    EXPECT_EQ(prices(book, gts::Side::Sell), (std::vector<gts::Fixed>{103, 105}));
+    EXPECT_EQ(book.sizeAt(gts::Side::Sell, 103), 2);
+}
+
+TEST(OrderBook, RemovalsShiftBetterLevelsUp) {
+    Book book;
+    for (gts::Fixed p : {100, 99, 98, 97}) book.update(gts::Side::Buy, p, 1);
+    book.update(gts::Side::Buy, 99, 0);
+    EXPECT_EQ(prices(book, gts::Side::Buy), (std::vector<gts::Fixed>{100, 98, 97}));
+    book.update(gts::Side::Buy, 97, 0);
+    book.update(gts::Side::Buy, 50, 0);
+    EXPECT_EQ(prices(book, gts::Side::Buy), (std::vector<gts::Fixed>{100, 98}));
+    book.update(gts::Side::Buy, 98, 7);
+    EXPECT_EQ(book.level(gts::Side::Buy, 1).size, 7);
+}
+
+TEST(OrderBook, MatchesReferenceUnderRandomUpdates) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<gts::Fixed> price(90, 110);
+    std::uniform_int_distribution<gts::Size> size(0, 3);
+    Book book;
+    std::vector<gts::BookLevel> reference;  // Bids, best first, same rules.
+    for (int step = 0; step < 20'000; ++step) {
+        const gts::Fixed p = price(rng);
+        const gts::Size s = size(rng);
+        book.update(gts::Side::Buy, p, s);
+
+        auto it = std::find_if(reference.begin(), reference.end(),
+                               [&](const gts::BookLevel& l) { return l.price <= p; });
+        if (it != reference.end() && it->price == p) {
+            if (s == 0) {
+                reference.erase(it);
+            } else {
+                it->size = s;
+            }
+        } else if (s != 0) {
+            reference.insert(it, gts::BookLevel{p, s});
+            if (reference.size() > 4) reference.pop_back();
+        }
+
+        ASSERT_EQ(book.depth(gts::Side::Buy), reference.size());
+        for (std::size_t i = 0; i < reference.size(); ++i) {
+            ASSERT_EQ(book.level(gts::Side::Buy, i).price, reference[i].price);
+            ASSERT_EQ(book.level(gts::Side::Buy, i).size, reference[i].size);
+        }
+    }
+}
+
+class Counting : public gts::Strategy {
+public:
+    void postEvent(const gts::Event& event) override {
+        ++events;
+        last = event;
+    }
+
+    int events = 0;
+    gts::Event last{};
+};
+
+TEST(BookBuilder, PostsTopOfBookOnlyWhenItChanges) {
+    Counting strategy;
+    gts::BookBuilder<4> builder(strategy);
+    builder.onDepth(gts::DepthUpdate{1, 2, gts::Side::Buy, 1.1, 5});
+    EXPECT_EQ(strategy.events, 1);
+    EXPECT_EQ(strategy.last.pair, 2);
+    EXPECT_EQ(strategy.last.bidSize, 5);
+
+    // Below the touch: the top is unchanged.
+    builder.onDepth(gts::DepthUpdate{2, 2, gts::Side::Buy, 1.0, 5});
+    EXPECT_EQ(strategy.events, 1);
+    EXPECT_EQ(builder.book(2).depth(gts::Side::Buy), 2u);
+
+    builder.onDepth(gts::DepthUpdate{3, 2, gts::Side::Buy, 1.1, 0});
+    EXPECT_EQ(strategy.events, 2);
+    EXPECT_EQ(strategy.last.bidPrice, 1.0);
+}
+
+TEST(BookBuilder, DropsUpdatesForPairsOutsideItsRange) {
+    Counting strategy;
+    gts::BookBuilder<4, 3> builder(strategy);
+    builder.onDepth(gts::DepthUpdate{1, 3, gts::Side::Buy, 1.1, 5});
+    builder.onQuote(gts::Event{2, 3, 1.1, 5, 1.2, 5});
+    builder.onQuote(gts::Event{3, gts::kMaxPairs, 1.1, 5, 1.2, 5});
+    EXPECT_EQ(strategy.events, 0);
+    EXPECT_EQ(builder.dropped(), 3u);
+
+    builder.onDepth(gts::DepthUpdate{4, 2, gts::Side::Buy, 1.1, 5});
+    EXPECT_EQ(strategy.events, 1);
+    EXPECT_EQ(builder.book(2).depth(gts::Side::Buy), 1u);
+}
+
+}  // namespace
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+
+#include "fake_sender.hpp"
+#include "gts/order_gateway.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::Tif;
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+std::string channelName(const char* name) {
+    return std::string("/gts_test_gw_") + name + "_" + std::to_string(::getpid());
+}
+
+TEST(OrderGateway, RoutesUpdatesBackToClient) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::FillInline;
+    gts::OrderGateway gateway(venue);
+    const std::string name = channelName("route");
+    gateway.addClient(name);
+    gts::GatewayClient client(name);
+    CountingObserver observer;
+    const gts::OrderId id = client.sendOrder(4, Side::Buy, 1.5, 200, Tif::IOC, observer);
+    EXPECT_NE(id, gts::kInvalidOrderId);
+    EXPECT_EQ(gateway.poll(), 1u);
+    EXPECT_EQ(client.poll(), 3u);
+    EXPECT_EQ(observer.acks, 1);
+    EXPECT_EQ(observer.filled, 200);
+    EXPECT_EQ(observer.terminated, 1);
+    ASSERT_EQ(venue.orders.size(), 1u);
+    EXPECT_EQ(venue.orders[0].pair, 4);
+}
+
+TEST(OrderGateway, RefusedOrderTerminatesAtClient) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::Refuse;
+    gts::OrderGateway gateway(venue);
+    const std::string name = channelName("refuse");
+    gateway.addClient(name);
+    gts::GatewayClient client(name);
+    CountingObserver observer;
+    client.sendOrder(0, Side::Sell, 1.0, 10, Tif::GTC, observer);
+    gateway.poll();
+    client.poll();
+    EXPECT_EQ(observer.acks, 0);
+    EXPECT_EQ(observer.terminated, 1);
+}
+
+TEST(GatewayClient, FullObserverTableRefusesBeforeSending) {
+    FakeSender venue;
+    gts::OrderGateway gateway(venue);
+    const std::string name = channelName("full");
+    gateway.addClient(name);
+    gts::GatewayClient client(name);
+    CountingObserver observer;
+    for (int i = 0; i < 4096; ++i) {
+        ASSERT_NE(client.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+        gateway.poll();
+    }
+    EXPECT_EQ(client.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(gateway.poll(), 0u);
+    EXPECT_EQ(venue.orders.size(), 4096u);
+
+    // Once an order is done its slot takes a new one.
+    venue.terminate(venue.orders[0]);
+    client.poll();
+    EXPECT_NE(client.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+}
+
+TEST(OrderGateway, StalledClientIsDisconnected) {
+    FakeSender venue;
+    gts::OrderGateway gateway(venue, std::chrono::microseconds(100));
+    const std::string stalledName = channelName("stalled");
+    const std::string liveName = channelName("live");
+    gateway.addClient(stalledName);
+    gateway.addClient(liveName);
+    gts::GatewayClient stalled(stalledName);
+    gts::GatewayClient live(liveName);
+    CountingObserver stalledObserver;
+    CountingObserver liveObserver;
+    stalled.sendOrder(0, Side::Buy, 1.0, 1'000'000, Tif::GTC, stalledObserver);
+    live.sendOrder(1, Side::Buy, 1.0, 10, Tif::GTC, liveObserver);
+    gateway.poll();
+    ASSERT_EQ(venue.orders.size(), 2u);
+
+    // The stalled client never polls: its ring fills and the gateway must
+    // give up instead of spinning inside the venue callback.
+    for (int i = 0; i < 5'000; ++i) venue.fill(venue.orders[0], 1);
+    EXPECT_TRUE(gateway.disconnected(0));
+    EXPECT_FALSE(gateway.disconnected(1));
+    EXPECT_EQ(gateway.disconnectedClients(), 1u);
+    EXPECT_FALSE(stalled.connected());
+    EXPECT_EQ(stalled.sendOrder(0, Side::Buy, 1.0, 1, Tif::IOC, stalledObserver), gts::kInvalidOrderId);
+
+    venue.ack(venue.orders[1]);
+    live.poll();
+    EXPECT_EQ(liveObserver.acks, 1);
+}
+
+}  // namespace
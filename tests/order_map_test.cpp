@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "gts/order_map.hpp"
+
+namespace {
+
+TEST(OrderMap, InsertFindErase) {
+    gts::OrderMap<int, 16> map;
+    ASSERT_NE(map.insert(1, 10), nullptr);
+    ASSERT_NE(map.insert(2, 20), nullptr);
+    EXPECT_EQ(*map.find(1), 10);
+    EXPECT_EQ(*map.insert(1, 11), 11);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_EQ(map.find(1), nullptr);
+    EXPECT_EQ(*map.find(2), 20);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(OrderMap, InsertFailsWhenFull) {
+    gts::OrderMap<int, 8> map;
+    for (gts::OrderId id = 1; id <= 8; ++id) ASSERT_NE(map.insert(id, 0), nullptr);
+    EXPECT_EQ(map.insert(9, 0), nullptr);
+    EXPECT_EQ(map.find(9), nullptr);
+}
+
+TEST(OrderMap, EraseFromFullMap) {
+    gts::OrderMap<int, 8> map;
+    for (gts::OrderId id = 1; id <= 8; ++id) map.insert(id, static_cast<int>(id));
+    EXPECT_TRUE(map.erase(3));
+    EXPECT_EQ(map.size(), 7u);
+    EXPECT_EQ(map.find(3), nullptr);
+    for (gts::OrderId id = 1; id <= 8; ++id) {
+        if (id != 3) {
+            ASSERT_NE(map.find(id), nullptr) << id;
+            EXPECT_EQ(*map.find(id), static_cast<int>(id));
+        }
+    }
+    // Drain the rest from full, one at a time.
+    ASSERT_NE(map.insert(3, 3), nullptr);
+    for (gts::OrderId id = 8; id >= 1; --id) {
+        EXPECT_TRUE(map.erase(id)) << id;
+    }
+    EXPECT_EQ(map.size(), 0u);
+}
+
+// Small tables under random churn exercise clusters that wrap past the last
+// slot, where backward shifting has to move entries across the boundary.
+template <std::size_t Capacity>
+void checkAgainstReference(unsigned seed) {
+    gts::OrderMap<gts::OrderId, Capacity> map;
+    std::unordered_map<gts::OrderId, gts::OrderId> reference;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<gts::OrderId> ids(1, Capacity * 2);
+    for (int step = 0; step < 20'000; ++step) {
+        const gts::OrderId id = ids(rng);
+        if (rng() % 2 == 0) {
+            const bool fits = reference.size() < Capacity || reference.count(id) != 0;
+            ASSERT_EQ(map.insert(id, id + step) != nullptr, fits);
+            if (fits) reference[id] = id + step;
+        } else {
+            ASSERT_EQ(map.erase(id), reference.erase(id) == 1);
+        }
+        ASSERT_EQ(map.size(), reference.size());
+        for (const auto& [key, value] : reference) {
+            const gts::OrderId* found = map.find(key);
+            ASSERT_NE(found, nullptr) << "step " << step << " id " << key;
+            ASSERT_EQ(*found, value);
+        }
+    }
+}
+
+TEST(OrderMap, WrapAroundChurnMatchesReference) {
+    checkAgainstReference<8>(1);
+    checkAgainstReference<16>(2);
+    checkAgainstReference<64>(3);
+}
+
+}  // namespace
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "gts/order_registry.hpp"
+
+namespace {
+
+using Registry = gts::OrderRegistry<int, 16>;
+
+TEST(OrderRegistry, CommitBindsStagedInfo) {
+    Registry registry;
+    ASSERT_TRUE(registry.stage(7));
+    EXPECT_TRUE(registry.commit(5));
+    ASSERT_NE(registry.find(5), nullptr);
+    EXPECT_EQ(*registry.find(5), 7);
+    EXPECT_EQ(registry.size(), 1u);
+}
+
+TEST(OrderRegistry, InlineAckBindsBeforeCommit) {
+    Registry registry;
+    registry.stage(7);
+    ASSERT_NE(registry.ack(5), nullptr);
+    EXPECT_EQ(*registry.update(5), 7);
+    EXPECT_TRUE(registry.erase(5));
+    // Terminated inline: commit must not register it again.
+    EXPECT_TRUE(registry.commit(5));
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+TEST(OrderRegistry, RefusedOrderIsNeverRegistered) {
+    Registry registry;
+    registry.stage(7);
+    EXPECT_FALSE(registry.commit(gts::kInvalidOrderId));
+    EXPECT_EQ(registry.size(), 0u);
+    EXPECT_EQ(registry.ack(gts::kInvalidOrderId), nullptr);
+    EXPECT_EQ(registry.ack(3), nullptr);
+}
+
+TEST(OrderRegistry, CallbackForOlderOrderDoesNotTakeStagedInfo) {
+    Registry registry;
+    registry.insert(1, 10);
+    registry.stage(20);
+    EXPECT_EQ(*registry.ack(1), 10);
+    EXPECT_TRUE(registry.commit(2));
+    EXPECT_EQ(*registry.find(2), 20);
+}
+
+TEST(OrderRegistry, LateCallbackForErasedOrderDoesNotTakeStagedInfo) {
+    Registry registry;
+    registry.insert(1, 10);
+    registry.erase(1);
+    registry.stage(20);
+    // A fill and termination for order 1 delivered inline during the send.
+    EXPECT_EQ(registry.update(1), nullptr);
+    EXPECT_EQ(registry.update(1), nullptr);
+    EXPECT_TRUE(registry.commit(2));
+    EXPECT_EQ(registry.find(1), nullptr);
+    ASSERT_NE(registry.find(2), nullptr);
+    EXPECT_EQ(*registry.find(2), 20);
+    EXPECT_EQ(registry.size(), 1u);
+}
+
+TEST(OrderRegistry, OrderTerminatedBeforeAckIsRefused) {
+    Registry registry;
+    registry.stage(7);
+    EXPECT_EQ(registry.update(5), nullptr);
+    EXPECT_FALSE(registry.commit(5));
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+TEST(OrderRegistry, FullTableRefusesToStage) {
+    Registry registry;
+    for (gts::OrderId id = 1; id <= 16; ++id) {
+        ASSERT_TRUE(registry.stage(static_cast<int>(id)));
+        ASSERT_TRUE(registry.commit(id));
+    }
+    EXPECT_EQ(registry.size(), 16u);
+    EXPECT_FALSE(registry.stage(17));
+    // Nothing staged: a callback for a new ID is not bound.
+    EXPECT_EQ(registry.ack(17), nullptr);
+
+    registry.erase(3);
+    ASSERT_TRUE(registry.stage(17));
+    EXPECT_TRUE(registry.commit(17));
+    EXPECT_EQ(*registry.find(17), 17);
+}
+
+}  // namespace
@@ -0,0 +1,105 @@
+// Exercise the violation log in every build type.
+#define GTS_ORDER_DIAGNOSTICS 1
+
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/order_state_machine.hpp"
+
+namespace {
+
+using gts::OrderEvent;
+using gts::OrderState;
+using gts::Side;
+using gts::Tif;
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+constexpr OrderState kStates[] = {OrderState::Sent, OrderState::Acked, OrderState::PartiallyFilled,
+                                  OrderState::Filled, OrderState::Terminated};
+constexpr OrderEvent kEvents[] = {OrderEvent::Ack, OrderEvent::PartialFill, OrderEvent::Fill,
+                                  OrderEvent::Terminate};
+
+// The full table spelled out as the transitions the venue protocol allows.
+OrderState expected(OrderState state, OrderEvent event) {
+    if (state == OrderState::Terminated) return OrderState::Invalid;
+    if (event == OrderEvent::Terminate) return OrderState::Terminated;
+    if (state == OrderState::Sent) return event == OrderEvent::Ack ? OrderState::Acked : OrderState::Invalid;
+    if (state == OrderState::Filled || event == OrderEvent::Ack) return OrderState::Invalid;
+    return event == OrderEvent::Fill ? OrderState::Filled : OrderState::PartiallyFilled;
+}
+
+TEST(OrderTransitions, TableMatchesProtocol) {
+    for (OrderState state : kStates) {
+        for (OrderEvent event : kEvents) {
+            EXPECT_EQ(gts::nextOrderState(state, event), expected(state, event))
+                << "state " << static_cast<int>(state) << " event " << static_cast<int>(event);
+        }
+    }
+}
+
+TEST(OrderTransitions, TableIsUsableAtCompileTime) {
+    static_assert(gts::nextOrderState(OrderState::Sent, OrderEvent::Ack) == OrderState::Acked);
+    static_assert(gts::nextOrderState(OrderState::Filled, OrderEvent::Fill) == OrderState::Invalid);
+}
+
+TEST(OrderLifecycle, TracksNormalLifecycle) {
+    FakeSender venue;
+    gts::OrderLifecycle lifecycle(venue);
+    CountingObserver observer;
+    const gts::OrderId id = lifecycle.sendOrder(0, Side::Buy, 1.0, 100, Tif::GTC, observer);
+    EXPECT_EQ(lifecycle.state(id), OrderState::Sent);
+    venue.ack(venue.orders[0]);
+    EXPECT_EQ(lifecycle.state(id), OrderState::Acked);
+    venue.fill(venue.orders[0], 40);
+    EXPECT_EQ(lifecycle.state(id), OrderState::PartiallyFilled);
+    venue.fill(venue.orders[0], 60);
+    EXPECT_EQ(lifecycle.state(id), OrderState::Filled);
+    venue.terminate(venue.orders[0]);
+    EXPECT_EQ(lifecycle.state(id), OrderState::Terminated);
+    EXPECT_EQ(lifecycle.violations(), 0u);
+    EXPECT_EQ(observer.fills, 2);
+    EXPECT_EQ(observer.terminated, 1);
+}
+
+TEST(OrderLifecycle, CountsInvalidTransitionsAndForwards) {
+    FakeSender venue;
+    gts::OrderLifecycle lifecycle(venue);
+    CountingObserver observer;
+    const gts::OrderId id = lifecycle.sendOrder(0, Side::Buy, 1.0, 100, Tif::GTC, observer);
+    venue.fill(venue.orders[0], 10);  // fill before ack
+    EXPECT_EQ(lifecycle.violations(), 1u);
+    EXPECT_EQ(lifecycle.state(id), OrderState::Sent);
+    EXPECT_EQ(observer.fills, 1);
+    venue.terminate(venue.orders[0]);
+    venue.ack(venue.orders[0]);  // after termination
+    EXPECT_EQ(lifecycle.violations(), 2u);
+    int logged = 0;
+    lifecycle.forEachViolation([&](const gts::OrderViolation& v) {
+        EXPECT_EQ(v.id, id);
+        ++logged;
+    });
+    EXPECT_EQ(logged, 2);
+}
+
+TEST(OrderLifecycle, InlineCallbacksAndRefusals) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::Refuse;
+    gts::OrderLifecycle lifecycle(venue);
+    CountingObserver observer;
+    EXPECT_EQ(lifecycle.sendOrder(0, Side::Buy, 1.0, 100, Tif::IOC, observer), gts::kInvalidOrderId);
+    venue.mode = FakeSender::Mode::FillInline;
+    lifecycle.sendOrder(0, Side::Buy, 1.0, 100, Tif::IOC, observer);
+    EXPECT_EQ(lifecycle.violations(), 0u);
+    EXPECT_EQ(observer.acks, 1);
+    EXPECT_EQ(observer.terminated, 1);
+
+    // Rejected inline before any ack: reported as a refusal, not a violation.
+    venue.mode = FakeSender::Mode::RejectInline;
+    EXPECT_EQ(lifecycle.sendOrder(0, Side::Buy, 1.0, 100, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(lifecycle.violations(), 0u);
+    EXPECT_EQ(observer.terminated, 1);
+    EXPECT_EQ(lifecycle.state(venue.orders.back().id), gts::OrderState::Terminated);
+}
+
+}  // namespace
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gts/order_book.hpp"
+#include "gts/pair_universe.hpp"
+
+namespace {
+
+inline constexpr auto kPairs = gts::makePairUniverse({
+    {"EUR", "USD"},
+    {"USD", "JPY"},
+    {"EUR", "JPY"},
+});
+
+class Registry {
+public:
+    void addPair(gts::PairId pair, const char* ccy1, const char* ccy2) {
+        added.push_back(std::to_string(pair) + ccy1 + ccy2);
+    }
+
+    std::vector<std::string> added;
+};
+
+class Ignore : public gts::Strategy {
+public:
+    void postEvent(const gts::Event&) override {}
+};
+
+TEST(PairUniverse, ResolvesIdsAtCompileTime) {
+    constexpr gts::PairId eurJpy = kPairs.id("EUR", "JPY");
+    static_assert(eurJpy == 2, "ID is the index in the list");
+    static_assert(kPairs.size() == 3, "");
+    static_assert(kPairs.contains(2) && !kPairs.contains(3), "");
+    EXPECT_EQ(kPairs[eurJpy].ccy1, "EUR");
+    EXPECT_THROW(kPairs.id("GBP", "USD"), std::invalid_argument);
+}
+
+TEST(PairUniverse, RegistersEveryPair) {
+    Registry registry;
+    gts::addPairs(registry, kPairs);
+    EXPECT_EQ(registry.added, (std::vector<std::string>{"0EURUSD", "1USDJPY", "2EURJPY"}));
+}
+
+TEST(PairUniverse, SizesBookBuilderToTheUniverse) {
+    using Sized = gts::BookBuilder<16, kPairs.size()>;
+    static_assert(sizeof(Sized) < sizeof(gts::BookBuilder<16>) / 16, "");
+    Ignore strategy;
+    Sized books(strategy);
+    books.onDepth(gts::DepthUpdate{0, kPairs.id("EUR", "JPY"), gts::Side::Buy, 160.0, 5});
+    EXPECT_EQ(books.book(2).depth(gts::Side::Buy), 1u);
+}
+
+}  // namespace
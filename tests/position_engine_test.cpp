@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/position_engine.hpp"
+
+namespace {
+
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+TEST(PositionEngine, AveragesAndRealizes) {
+    gts::PositionEngine engine;
+    engine.onFill(0, gts::Side::Buy, 1.10, 100, 1);
+    engine.onFill(0, gts::Side::Buy, 1.20, 100, 2);
+    EXPECT_EQ(engine.snapshot(0).averagePrice, gts::toFixed(1.15));
+    engine.onFill(0, gts::Side::Sell, 1.25, 150, 3);
+    const gts::PositionSnapshot snap = engine.snapshot(0);
+    EXPECT_EQ(snap.ccy1Position, 50);
+    EXPECT_EQ(snap.realizedPnl, gts::toFixed(0.10) * 150);
+    EXPECT_EQ(snap.averagePrice, gts::toFixed(1.15));
+}
+
+TEST(PositionTracker, ForwardsInlineFills) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::FillInline;
+    gts::PositionEngine engine;
+    gts::PositionTracker tracker(venue, engine);
+    CountingObserver observer;
+    tracker.sendOrder(2, gts::Side::Sell, 1.5, 300, gts::Tif::IOC, observer);
+    EXPECT_EQ(engine.snapshot(2).ccy1Position, -300);
+    EXPECT_EQ(observer.acks, 1);
+    EXPECT_EQ(observer.filled, 300);
+    EXPECT_EQ(observer.terminated, 1);
+}
+
+TEST(PositionTracker, RefusedOrderLeavesNoState) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::Refuse;
+    gts::PositionEngine engine;
+    gts::PositionTracker tracker(venue, engine);
+    CountingObserver refusedObserver;
+    EXPECT_EQ(tracker.sendOrder(1, gts::Side::Buy, 1.0, 100, gts::Tif::GTC, refusedObserver),
+              gts::kInvalidOrderId);
+
+    // The next order's callbacks must reach its own observer.
+    venue.mode = FakeSender::Mode::Open;
+    CountingObserver observer;
+    tracker.sendOrder(1, gts::Side::Buy, 1.0, 100, gts::Tif::GTC, observer);
+    venue.fill(venue.orders[0], 40);
+    EXPECT_EQ(observer.filled, 40);
+    EXPECT_EQ(refusedObserver.fills, 0);
+    EXPECT_EQ(engine.snapshot(1).ccy1Position, 40);
+}
+
+}  // namespace
@@ -0,0 +1,63 @@
+#define GTS_PROFILING 1
+
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/profiler.hpp"
+#include "gts/throttle.hpp"
+
+namespace {
+
+using gts::Stage;
+
+class Sending : public gts::Strategy {
+public:
+    explicit Sending(gts::OrderSender& sender) : sender_(sender) {}
+
+    void postEvent(const gts::Event& event) override {
+        sender_.sendOrder(event.pair, gts::Side::Buy, event.askPrice, 1, gts::Tif::IOC, observer_);
+    }
+
+private:
+    gts::OrderSender& sender_;
+    gts::test::CountingObserver observer_;
+};
+
+TEST(StageProfiler, StrategyLogicExcludesNestedStages) {
+    gts::StageProfiler& profiler = gts::StageProfiler::instance();
+    const auto before = [&](Stage s) { return profiler.ticks(s); };
+    const std::uint64_t postBefore = before(Stage::PostEvent);
+    const std::uint64_t strategyBefore = before(Stage::StrategyLogic);
+    const std::uint64_t riskBefore = before(Stage::RiskCheck);
+    const std::uint64_t postCount = profiler.count(Stage::PostEvent);
+
+    gts::test::FakeSender venue;
+    gts::Throttle throttle(1'000'000, 1'000);
+    gts::ThrottledOrderSender sender(venue, throttle);
+    Sending strategy(sender);
+    gts::ProfiledStrategy profiled(strategy);
+    for (int i = 0; i < 10; ++i) profiled.postEvent(gts::Event{0, 1, 1.0, 1, 1.1, 1});
+
+    EXPECT_EQ(profiler.count(Stage::PostEvent) - postCount, 10u);
+    EXPECT_EQ(profiler.count(Stage::StrategyLogic), profiler.count(Stage::PostEvent));
+    EXPECT_GE(profiler.count(Stage::RiskCheck), 10u);
+    EXPECT_EQ((profiler.ticks(Stage::StrategyLogic) - strategyBefore) +
+                  (profiler.ticks(Stage::RiskCheck) - riskBefore),
+              profiler.ticks(Stage::PostEvent) - postBefore);
+}
+
+TEST(StageProfiler, DiscardedSampleIsNotRecorded) {
+    gts::StageProfiler& profiler = gts::StageProfiler::instance();
+    const std::uint64_t reads = profiler.count(Stage::SocketRead);
+    {
+        GTS_PROFILE_STAGE_AS(timer, SocketRead);
+        GTS_PROFILE_DISCARD(timer);
+    }
+    EXPECT_EQ(profiler.count(Stage::SocketRead), reads);
+    {
+        GTS_PROFILE_STAGE(SocketRead);
+    }
+    EXPECT_EQ(profiler.count(Stage::SocketRead), reads + 1);
+}
+
+}  // namespace
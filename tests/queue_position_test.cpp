@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "gts/queue_position.hpp"
+
+namespace {
+
+using Estimator = gts::QueuePositionEstimator;
+
+TEST(QueuePositionEstimator, TradesAndCancelsShrinkTheQueueAhead) {
+    Estimator estimator;
+    const gts::Fixed price = gts::toFixed(1.1);
+    const Estimator::Handle h = estimator.track(0, gts::Side::Buy, 1.1, 10, 90);
+    ASSERT_NE(h, Estimator::kNoHandle);
+    EXPECT_EQ(estimator.queueAhead(h), 90);
+
+    // Trades at our price come off the front.
+    estimator.onTrade(gts::Trade{0, 0, gts::Side::Sell, 1.1, 30});
+    estimator.onLevel(0, gts::Side::Buy, price, 70);
+    EXPECT_EQ(estimator.queueAhead(h), 60);
+
+    // Other decreases are cancels, spread over everyone else: all 60 other
+    // lots are ahead of us, so the whole cancel is ahead.
+    estimator.onLevel(0, gts::Side::Buy, price, 40);
+    EXPECT_EQ(estimator.queueAhead(h), 30);
+
+    // Size joining the level queues behind us.
+    estimator.onLevel(0, gts::Side::Buy, price, 100);
+    EXPECT_EQ(estimator.queueAhead(h), 30);
+
+    estimator.onFill(h, 5);
+    EXPECT_EQ(estimator.queueAhead(h), 0);
+}
+
+TEST(QueuePositionEstimator, FullTableHandsOutNoHandleThatIsSafeToUse) {
+    Estimator estimator;
+    for (std::size_t i = 0; i < Estimator::kMaxOrders; ++i) {
+        ASSERT_NE(estimator.track(0, gts::Side::Buy, 1.1, 1, 1), Estimator::kNoHandle);
+    }
+    const Estimator::Handle none = estimator.track(0, gts::Side::Buy, 1.1, 1, 1);
+    ASSERT_EQ(none, Estimator::kNoHandle);
+    EXPECT_EQ(estimator.queueAhead(none), std::numeric_limits<gts::Size>::max());
+    estimator.onFill(none, 1);
+    estimator.untrack(none);
+
+    // Freed slots are reused.
+    estimator.untrack(7);
+    EXPECT_EQ(estimator.track(0, gts::Side::Buy, 1.1, 1, 1), 7);
+}
+
+}  // namespace
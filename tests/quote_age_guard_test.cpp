@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/quote_age_guard.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::StaleQuoteAction;
+using gts::Tif;
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+constexpr gts::Timestamp kMaxAge = 1'000;
+
+gts::Event quote(gts::PairId pair, gts::Timestamp venueTime = 0) {
+    return gts::Event{venueTime, pair, 1.10, 1, 1.11, 1};
+}
+
+TEST(QuoteAgeGuard, FreshQuotePassesOrderThrough) {
+    FakeSender venue;
+    gts::QuoteAgeGuard guard(venue, kMaxAge);
+    CountingObserver observer;
+    guard.onEvent(quote(1), 5'000);
+    EXPECT_TRUE(guard.isFresh(1, 6'000));
+    EXPECT_NE(guard.sendOrder(1, Side::Buy, 1.10, 100, Tif::IOC, observer, 6'000),
+              gts::kInvalidOrderId);
+    ASSERT_EQ(venue.orders.size(), 1u);
+    EXPECT_EQ(venue.orders[0].price, 1.10);
+    EXPECT_EQ(guard.staleOrders(), 0u);
+}
+
+TEST(QuoteAgeGuard, RejectRefusesStaleAndUnquotedPairs) {
+    FakeSender venue;
+    gts::QuoteAgeGuard guard(venue, kMaxAge);
+    CountingObserver observer;
+    guard.onEvent(quote(1), 5'000);
+    EXPECT_FALSE(guard.isFresh(1, 6'001));
+    EXPECT_EQ(guard.sendOrder(1, Side::Buy, 1.10, 100, Tif::IOC, observer, 6'001),
+              gts::kInvalidOrderId);
+    EXPECT_EQ(guard.sendOrder(2, Side::Buy, 1.10, 100, Tif::IOC, observer, 6'000),
+              gts::kInvalidOrderId);
+    EXPECT_TRUE(venue.orders.empty());
+    EXPECT_EQ(guard.staleOrders(), 2u);
+
+    // A new quote makes the pair fresh again.
+    guard.onEvent(quote(1), 6'001);
+    EXPECT_NE(guard.sendOrder(1, Side::Buy, 1.10, 100, Tif::IOC, observer, 6'001),
+              gts::kInvalidOrderId);
+}
+
+TEST(QuoteAgeGuard, RepriceMovesStaleOrdersAwayFromTheMarket) {
+    FakeSender venue;
+    gts::QuoteAgeGuard guard(venue, kMaxAge, StaleQuoteAction::Reprice, 0.01);
+    CountingObserver observer;
+    guard.onEvent(quote(1), 0);
+    guard.sendOrder(1, Side::Buy, 1.10, 100, Tif::GTC, observer, 2'000);
+    guard.sendOrder(1, Side::Sell, 1.11, 100, Tif::GTC, observer, 2'000);
+    guard.sendOrder(1, Side::Buy, 1.10, 100, Tif::GTC, observer, 500);
+    ASSERT_EQ(venue.orders.size(), 3u);
+    EXPECT_DOUBLE_EQ(venue.orders[0].price, 1.09);
+    EXPECT_DOUBLE_EQ(venue.orders[1].price, 1.12);
+    EXPECT_DOUBLE_EQ(venue.orders[2].price, 1.10);
+    EXPECT_EQ(guard.staleOrders(), 2u);
+}
+
+TEST(QuoteAgeGuard, AgeIsMeasuredFromLocalReceiveTime) {
+    FakeSender venue;
+    gts::QuoteAgeGuard guard(venue, 1'000'000'000);
+    CountingObserver observer;
+    // The venue stamp is far behind the local clock, but the quote was
+    // received just now.
+    guard.onEvent(quote(1, 1));
+    gts::OrderSender& sender = guard;
+    EXPECT_NE(sender.sendOrder(1, Side::Buy, 1.10, 100, Tif::IOC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(guard.staleOrders(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gts/replay.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::Tif;
+
+struct Fill {
+    gts::OrderId id;
+    gts::Price price;
+    gts::Size size;
+};
+
+struct Recorder : gts::OrderStateObserver {
+    void onAck(gts::OrderId) override { ++acks; }
+    void onFill(gts::OrderId id, gts::Price price, gts::Size size) override {
+        fills.push_back({id, price, size});
+    }
+    void onTerminated(gts::OrderId) override { ++terminated; }
+
+    int acks = 0;
+    int terminated = 0;
+    std::vector<Fill> fills;
+};
+
+gts::Event quote(gts::PairId pair, gts::Price bid, gts::Size bidSize, gts::Price ask, gts::Size askSize) {
+    return gts::Event{0, pair, bid, bidSize, ask, askSize};
+}
+
+std::string tickPath(const std::string& name) {
+    return ::testing::TempDir() + name + std::to_string(::getpid()) + ".bin";
+}
+
+void writeTicks(const std::string& path, std::size_t count) {
+    gts::TickFileWriter writer(path);
+    for (std::size_t i = 0; i < count; ++i) {
+        writer.append(quote(1, 1.10, 100, 1.11, 100));
+    }
+    writer.close();
+}
+
+TEST(SimulatedExchange, IocFillsAgainstTheTouchAndTerminates) {
+    gts::SimulatedExchange exchange;
+    exchange.onEvent(quote(1, 1.10, 100, 1.11, 100));
+    Recorder observer;
+    exchange.sendOrder(1, Side::Buy, 1.12, 150, Tif::IOC, observer);
+    EXPECT_EQ(observer.acks, 1);
+    ASSERT_EQ(observer.fills.size(), 1u);
+    EXPECT_EQ(observer.fills[0].price, 1.11);
+    EXPECT_EQ(observer.fills[0].size, 100);
+    EXPECT_EQ(observer.terminated, 1);
+
+    // The touch size is used up until the next quote.
+    exchange.sendOrder(1, Side::Buy, 1.12, 10, Tif::IOC, observer);
+    EXPECT_EQ(observer.fills.size(), 1u);
+    EXPECT_EQ(observer.terminated, 2);
+
+    // Below the touch nothing trades.
+    exchange.sendOrder(1, Side::Sell, 1.11, 10, Tif::IOC, observer);
+    EXPECT_EQ(observer.fills.size(), 1u);
+    EXPECT_EQ(observer.terminated, 3);
+
+    const gts::BacktestResult result = exchange.result();
+    EXPECT_EQ(result.orders, 3u);
+    EXPECT_EQ(result.fills, 1u);
+    EXPECT_EQ(result.volume, 100);
+}
+
+TEST(SimulatedExchange, GtcRestsAndFillsAtItsLimitOnALaterQuote) {
+    gts::SimulatedExchange exchange;
+    exchange.onEvent(quote(1, 1.10, 100, 1.11, 40));
+    Recorder observer;
+    const gts::OrderId id = exchange.sendOrder(1, Side::Buy, 1.11, 100, Tif::GTC, observer);
+    ASSERT_EQ(observer.fills.size(), 1u);
+    EXPECT_EQ(observer.fills[0].size, 40);
+    EXPECT_EQ(observer.terminated, 0);
+
+    // Quotes on other pairs or not crossing the limit leave it resting.
+    exchange.onEvent(quote(2, 1.00, 100, 1.01, 100));
+    exchange.onEvent(quote(1, 1.10, 100, 1.12, 100));
+    EXPECT_EQ(observer.fills.size(), 1u);
+
+    exchange.onEvent(quote(1, 1.09, 100, 1.10, 30));
+    ASSERT_EQ(observer.fills.size(), 2u);
+    EXPECT_EQ(observer.fills[1].id, id);
+    EXPECT_EQ(observer.fills[1].price, 1.11);
+    EXPECT_EQ(observer.fills[1].size, 30);
+    EXPECT_EQ(observer.terminated, 0);
+
+    exchange.onEvent(quote(1, 1.09, 100, 1.10, 100));
+    ASSERT_EQ(observer.fills.size(), 3u);
+    EXPECT_EQ(observer.fills[2].size, 30);
+    EXPECT_EQ(observer.terminated, 1);
+
+    exchange.onEvent(quote(1, 1.09, 100, 1.10, 100));
+    EXPECT_EQ(observer.fills.size(), 3u);
+    EXPECT_EQ(exchange.result().volume, 100);
+}
+
+TEST(TickFile, RoundTripsAndRejectsPartialRecords) {
+    const std::string path = tickPath("ticks_roundtrip");
+    writeTicks(path, 3);
+    EXPECT_EQ(gts::loadTickFile(path).size(), 3u);
+
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    ASSERT_NE(file, nullptr);
+    std::fputc(0, file);
+    std::fclose(file);
+    EXPECT_THROW(gts::loadTickFile(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(TickFile, CloseReportsWriteErrors) {
+    if (::access("/dev/full", W_OK) != 0) {
+        GTEST_SKIP() << "/dev/full not available";
+    }
+    gts::TickFileWriter writer("/dev/full");
+    writer.append(quote(1, 1.10, 100, 1.11, 100));
+    EXPECT_THROW(writer.close(), std::system_error);
+}
+
+// Sends one IOC through the touch on every quote.
+class Taker : public gts::Strategy, private gts::OrderStateObserver {
+public:
+    explicit Taker(gts::OrderSender& sender) : sender_(sender) {}
+
+    void postEvent(const gts::Event& event) override {
+        sender_.sendOrder(event.pair, Side::Buy, event.askPrice, 10, Tif::IOC, *this);
+    }
+
+private:
+    void onAck(gts::OrderId) override {}
+    void onFill(gts::OrderId, gts::Price, gts::Size) override {}
+    void onTerminated(gts::OrderId) override {}
+
+    gts::OrderSender& sender_;
+};
+
+std::unique_ptr<gts::Strategy> makeTaker(gts::OrderSender& sender, std::size_t) {
+    return std::make_unique<Taker>(sender);
+}
+
+TEST(Replay, ShardedResultsFollowPathOrder) {
+    std::vector<std::string> paths;
+    for (std::size_t i = 0; i < 5; ++i) {
+        paths.push_back(tickPath("ticks_shard" + std::to_string(i)));
+        writeTicks(paths.back(), i + 1);
+    }
+    const std::vector<gts::BacktestResult> results = gts::runSharded(paths, makeTaker, 3);
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].events, i + 1);
+        EXPECT_EQ(results[i].orders, i + 1);
+        EXPECT_EQ(results[i].volume, static_cast<gts::Size>(10 * (i + 1)));
+    }
+
+    const gts::BacktestResult carried = gts::runSequential(paths, makeTaker);
+    EXPECT_EQ(carried.events, 15u);
+    EXPECT_EQ(carried.orders, 15u);
+    for (const std::string& path : paths) std::remove(path.c_str());
+}
+
+TEST(Replay, BadShardExceptionPropagates) {
+    const std::string good = tickPath("ticks_good");
+    const std::string missing = tickPath("ticks_missing");
+    writeTicks(good, 2);
+    std::remove(missing.c_str());
+    EXPECT_THROW(gts::runSharded({good, missing, good}, makeTaker, 2), std::system_error);
+    EXPECT_THROW(gts::runSequential({good, missing}, makeTaker), std::system_error);
+
+    std::FILE* file = std::fopen(missing.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not ticks", file);
+    std::fclose(file);
+    EXPECT_THROW(gts::runSharded({good, missing}, makeTaker, 2), std::runtime_error);
+    std::remove(good.c_str());
+    std::remove(missing.c_str());
+}
+
+}  // namespace
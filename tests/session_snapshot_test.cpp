@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "fake_sender.hpp"
+#include "gts/session_snapshot.hpp"
+#include "gts/tagged_orders.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::Tif;
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+struct StrategyState {
+    int quotesSeen;
+};
+
+using Snapshot = gts::SnapshotFile<StrategyState>;
+
+// The decorator chain a strategy would run: lifecycle -> sizer -> tracker -> venue.
+struct Chain {
+    FakeSender venue;
+    gts::PositionEngine engine;
+    gts::PositionTracker tracker{venue, engine};
+    gts::SpotLimitSizer sizer{tracker, 1'000'000};
+    gts::OrderLifecycle lifecycle{sizer};
+};
+
+std::string snapshotPath(const char* name) {
+    return ::testing::TempDir() + name + std::to_string(::getpid());
+}
+
+TEST(SnapshotFile, UncommittedStagingKeepsPreviousSnapshot) {
+    const std::string path = snapshotPath("snapshot_staging");
+    std::remove(path.c_str());
+    Snapshot file(path);
+    EXPECT_EQ(file.latest(), nullptr);
+    file.staging().strategy.quotesSeen = 1;
+    file.commit(true);
+    ASSERT_NE(file.latest(), nullptr);
+    file.staging().strategy.quotesSeen = 2;
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 1);
+    file.commit();
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 2);
+    std::remove(path.c_str());
+}
+
+TEST(SnapshotFile, ShortFileIsGrownAndStartsEmpty) {
+    const std::string path = snapshotPath("snapshot_short");
+    std::ofstream(path) << "GTS";
+    Snapshot file(path);
+    EXPECT_EQ(file.latest(), nullptr);
+    // The whole layout is backed by the file, the second slot included.
+    file.staging().strategy.quotesSeen = 1;
+    file.commit();
+    file.staging().strategy.quotesSeen = 2;
+    file.commit(true);
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 2);
+    std::remove(path.c_str());
+}
+
+TEST(PeriodicSnapshotWriter, WritesOncePerInterval) {
+    const std::string path = snapshotPath("snapshot_periodic");
+    std::remove(path.c_str());
+    Chain chain;
+    Snapshot file(path);
+    StrategyState state{1};
+    gts::PeriodicSnapshotWriter<StrategyState> writer(file, chain.engine, chain.sizer,
+                                                      chain.lifecycle, state, 1'000);
+
+    EXPECT_TRUE(writer.maybeWrite(1'000));
+    ASSERT_NE(file.latest(), nullptr);
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 1);
+    EXPECT_EQ(file.latest()->orderCount, 0u);
+
+    state.quotesSeen = 2;
+    CountingObserver observer;
+    chain.lifecycle.sendOrder(1, Side::Buy, 1.10, 100'000, Tif::GTC, observer);
+    EXPECT_FALSE(writer.maybeWrite(1'999));
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 1);
+
+    EXPECT_TRUE(writer.maybeWrite(2'000));
+    EXPECT_EQ(file.latest()->strategy.quotesSeen, 2);
+    EXPECT_EQ(file.latest()->orderCount, 1u);
+    EXPECT_EQ(file.latest()->spotUsed, 100'000);
+    EXPECT_EQ(writer.written(), 2u);
+    EXPECT_EQ(writer.incomplete(), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(SessionImage, WarmRestartRestoresOrdersPositionsAndExposure) {
+    const std::string path = snapshotPath("snapshot_restart");
+    std::remove(path.c_str());
+    CountingObserver before;
+    gts::Size usedBefore = 0;
+    gts::OrderId openId = 0;
+    {
+        Chain chain;
+        chain.lifecycle.sendOrder(1, Side::Buy, 1.10, 200'000, Tif::IOC, before);
+        chain.venue.ack(chain.venue.orders[0]);
+        chain.venue.fill(chain.venue.orders[0], 200'000);
+        chain.venue.terminate(chain.venue.orders[0]);
+        openId = chain.lifecycle.sendOrder(2, Side::Sell, 1.30, 500'000, Tif::GTC, before);
+        chain.venue.ack(chain.venue.orders[1]);
+        chain.venue.fill(chain.venue.orders[1], 100'000);
+        usedBefore = chain.sizer.used();
+        EXPECT_EQ(usedBefore, 200'000 + 500'000);
+
+        Snapshot file(path);
+        Snapshot::Image& image = file.staging();
+        EXPECT_TRUE(image.capture(chain.engine, chain.sizer, chain.lifecycle));
+        image.strategy.quotesSeen = 42;
+        file.commit(true);
+    }
+
+    Chain chain;
+    Snapshot file(path);
+    const Snapshot::Image* image = file.latest();
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->strategy.quotesSeen, 42);
+    ASSERT_EQ(image->orderCount, 1u);
+    EXPECT_EQ(image->orders[0].remaining, 400'000);
+
+    CountingObserver after;
+    EXPECT_TRUE(image->restore(chain.engine, chain.sizer, chain.lifecycle, after));
+    EXPECT_EQ(chain.sizer.used(), usedBefore);
+    EXPECT_EQ(chain.engine.snapshot(1).ccy1Position, 200'000);
+    EXPECT_EQ(chain.engine.snapshot(2).ccy1Position, -100'000);
+    EXPECT_EQ(chain.lifecycle.state(openId), gts::OrderState::PartiallyFilled);
+    EXPECT_GT(chain.venue.nextId, openId);
+
+    // The restored order's callbacks flow through the whole chain again.
+    ASSERT_EQ(chain.venue.orders.size(), 1u);
+    chain.venue.fill(chain.venue.orders[0], 400'000);
+    chain.venue.terminate(chain.venue.orders[0]);
+    EXPECT_EQ(after.filled, 400'000);
+    EXPECT_EQ(after.terminated, 1);
+    EXPECT_EQ(chain.engine.snapshot(2).ccy1Position, -500'000);
+    EXPECT_EQ(chain.sizer.used(), 700'000);
+    EXPECT_EQ(chain.lifecycle.violations(), 0u);
+
+    const gts::OrderId next = chain.lifecycle.sendOrder(1, Side::Sell, 1.1, 1, Tif::IOC, after);
+    EXPECT_GT(next, openId);
+    std::remove(path.c_str());
+}
+
+struct Level {
+    int level;
+};
+
+struct LevelObserver : gts::TaggedObserver<Level> {
+    void onAck(gts::OrderId, Level&) override {}
+    void onFill(gts::OrderId, gts::Price, gts::Size size, Level& tag) override {
+        lastLevel = tag.level;
+        filled += size;
+    }
+    void onTerminated(gts::OrderId, Level&) override { ++terminated; }
+
+    int lastLevel = 0;
+    gts::Size filled = 0;
+    int terminated = 0;
+};
+
+// The strategy keeps its tags in its own snapshot state.
+struct LadderState {
+    gts::OrderId id;
+    Level tag;
+};
+
+TEST(SessionImage, WarmRestartRestoresTaggedOrders) {
+    const std::string path = snapshotPath("snapshot_tagged");
+    std::remove(path.c_str());
+    using LadderSnapshot = gts::SnapshotFile<LadderState>;
+    gts::OrderId openId = 0;
+    {
+        Chain chain;
+        gts::TaggedOrderSender<Level, 16> tagged(chain.lifecycle);
+        LevelObserver before;
+        openId = tagged.sendOrder(2, Side::Sell, 1.30, 500'000, Tif::GTC, before, Level{3});
+        chain.venue.ack(chain.venue.orders[0]);
+        chain.venue.fill(chain.venue.orders[0], 100'000);
+        EXPECT_EQ(before.lastLevel, 3);
+
+        LadderSnapshot file(path);
+        LadderSnapshot::Image& image = file.staging();
+        EXPECT_TRUE(image.capture(chain.engine, chain.sizer, chain.lifecycle));
+        image.strategy = LadderState{openId, Level{3}};
+        file.commit();
+    }
+
+    Chain chain;
+    gts::TaggedOrderSender<Level, 16> tagged(chain.lifecycle);
+    LevelObserver after;
+    LadderSnapshot file(path);
+    const LadderSnapshot::Image* image = file.latest();
+    ASSERT_NE(image, nullptr);
+    EXPECT_TRUE(image->restoreEach(chain.engine, chain.sizer, tagged,
+                                   [&](const gts::SnapshotOrder& order) {
+                                       ASSERT_EQ(order.id, image->strategy.id);
+                                       tagged.restoreOrder(order, after, image->strategy.tag);
+                                   }));
+    EXPECT_EQ(tagged.available(), 15u);
+    EXPECT_EQ(chain.lifecycle.state(openId), gts::OrderState::PartiallyFilled);
+
+    // Callbacks reach the strategy with its tag, and the slot is released on
+    // termination.
+    ASSERT_EQ(chain.venue.orders.size(), 1u);
+    chain.venue.fill(chain.venue.orders[0], 400'000);
+    chain.venue.terminate(chain.venue.orders[0]);
+    EXPECT_EQ(after.lastLevel, 3);
+    EXPECT_EQ(after.filled, 400'000);
+    EXPECT_EQ(after.terminated, 1);
+    EXPECT_EQ(tagged.available(), 16u);
+    EXPECT_EQ(chain.lifecycle.violations(), 0u);
+    EXPECT_GT(tagged.sendOrder(1, Side::Buy, 1.1, 1, Tif::IOC, after, Level{1}), openId);
+    std::remove(path.c_str());
+}
+
+}  // namespace
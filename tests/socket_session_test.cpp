@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fake_sender.hpp"
+#include "gts/socket_session.hpp"
+
+namespace {
+
+class Recording : public gts::Strategy {
+public:
+    void postEvent(const gts::Event& event) override { seen.push_back(event.timestamp); }
+
+    std::vector<gts::Timestamp> seen;
+};
+
+// A venue on a loopback port with one connected session.
+class Venue {
+public:
+    Venue() {
+        const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listener, 1);
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+        session = std::make_unique<gts::SocketSession>("127.0.0.1", ntohs(addr.sin_port));
+        fd = ::accept(listener, nullptr, nullptr);
+        ::close(listener);
+    }
+
+    ~Venue() {
+        session.reset();
+        ::close(fd);
+    }
+
+    void write(const void* data, std::size_t size) {
+        ASSERT_EQ(::send(fd, data, size, 0), static_cast<ssize_t>(size));
+    }
+
+    // Polls until the bytes written so far have been read.
+    bool pollAll(gts::Strategy& strategy) {
+        bool open = true;
+        for (int i = 0; i < 100 && open; ++i) {
+            open = session->poll(strategy);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return open;
+    }
+
+    int fd = -1;
+    std::unique_ptr<gts::SocketSession> session;
+};
+
+gts::wire::Tick tick(std::uint64_t sequence) {
+    return gts::wire::Tick{gts::wire::header<gts::wire::Tick>(gts::wire::MsgType::Tick), sequence,
+                           gts::Event{static_cast<gts::Timestamp>(sequence), 0, 1.0, 1, 1.1, 1}};
+}
+
+TEST(SocketSession, DeliversTicks) {
+    Venue venue;
+    Recording strategy;
+    const gts::wire::Tick ticks[] = {tick(1), tick(2)};
+    venue.write(ticks, sizeof(ticks));
+    EXPECT_TRUE(venue.pollAll(strategy));
+    EXPECT_EQ(strategy.seen, (std::vector<gts::Timestamp>{1, 2}));
+}
+
+TEST(SocketSession, RejectsZeroLengthFrame) {
+    Venue venue;
+    Recording strategy;
+    gts::wire::Tick bad = tick(1);
+    bad.header.length = 0;
+    venue.write(&bad, sizeof(bad));
+    EXPECT_THROW(venue.pollAll(strategy), std::runtime_error);
+}
+
+TEST(SocketSession, RejectsFrameShorterThanItsType) {
+    Venue venue;
+    Recording strategy;
+    gts::wire::Tick bad = tick(1);
+    bad.header.length = sizeof(gts::wire::Header);
+    venue.write(&bad, sizeof(bad));
+    EXPECT_THROW(venue.pollAll(strategy), std::runtime_error);
+}
+
+TEST(SocketSession, RejectsFrameLongerThanTheBuffer) {
+    Venue venue;
+    Recording strategy;
+    gts::wire::Tick bad = tick(1);
+    bad.header.length = 1 << 20;
+    venue.write(&bad, sizeof(bad));
+    EXPECT_THROW(venue.pollAll(strategy), std::runtime_error);
+}
+
+TEST(SocketSession, FullObserverTableRefusesBeforeWriting) {
+    Venue venue;
+    std::thread drain([&] {
+        char buffer[4096];
+        while (::recv(venue.fd, buffer, sizeof(buffer), 0) > 0) {
+        }
+    });
+    gts::test::CountingObserver observer;
+    for (int i = 0; i < 4096; ++i) {
+        ASSERT_NE(venue.session->sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::GTC, observer),
+                  gts::kInvalidOrderId);
+    }
+    EXPECT_EQ(venue.session->sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::GTC, observer),
+              gts::kInvalidOrderId);
+    venue.session.reset();
+    drain.join();
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/spot_limit.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::SizingMode;
+using gts::Tif;
+using gts::test::CountingObserver;
+using gts::test::FakeSender;
+
+TEST(SpotLimitSizer, ConservativeReservesInFlightSize) {
+    FakeSender venue;
+    gts::SpotLimitSizer sizer(venue, 1'000);
+    CountingObserver observer;
+    EXPECT_NE(sizer.sendOrder(0, Side::Buy, 1.0, 600, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(sizer.used(), 600);
+    EXPECT_EQ(sizer.maxOrderSize(1, Side::Buy), 400);
+    EXPECT_EQ(sizer.sendOrder(1, Side::Buy, 1.0, 500, Tif::GTC, observer), gts::kInvalidOrderId);
+
+    venue.fill(venue.orders[0], 200);
+    EXPECT_EQ(sizer.position(0), 200);
+    EXPECT_EQ(sizer.used(), 600);
+    venue.terminate(venue.orders[0]);
+    EXPECT_EQ(sizer.used(), 200);
+    EXPECT_EQ(sizer.maxOrderSize(1, Side::Buy), 800);
+    EXPECT_EQ(observer.fills, 1);
+    EXPECT_EQ(observer.terminated, 1);
+}
+
+TEST(SpotLimitSizer, FilledModeIgnoresInFlight) {
+    FakeSender venue;
+    gts::SpotLimitSizer sizer(venue, 1'000, SizingMode::Filled);
+    CountingObserver observer;
+    sizer.sendOrder(0, Side::Buy, 1.0, 900, Tif::GTC, observer);
+    EXPECT_EQ(sizer.used(), 0);
+    venue.fill(venue.orders[0], 900);
+    EXPECT_EQ(sizer.used(), 900);
+    EXPECT_EQ(sizer.maxOrderSize(0, Side::Buy), 100);
+    EXPECT_EQ(sizer.maxOrderSize(0, Side::Sell), 1'900);
+}
+
+TEST(SpotLimitSizer, ReducingOrdersAllowedOverLimit) {
+    FakeSender venue;
+    gts::SpotLimitSizer sizer(venue, 1'000);
+    sizer.restorePosition(0, 1'500);
+    EXPECT_EQ(sizer.maxOrderSize(0, Side::Buy), 0);
+    EXPECT_EQ(sizer.maxOrderSize(0, Side::Sell), 2'500);
+}
+
+TEST(SpotLimitSizer, RefusedSendReleasesReservation) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::Refuse;
+    gts::SpotLimitSizer sizer(venue);
+    CountingObserver observer;
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(sizer.sendOrder(0, Side::Buy, 1.0, 1'000'000, Tif::GTC, observer),
+                  gts::kInvalidOrderId);
+    }
+    EXPECT_EQ(venue.refused, 20);
+    EXPECT_EQ(sizer.used(), 0);
+    EXPECT_EQ(sizer.maxOrderSize(0, Side::Buy), gts::kTotalSpotLimit);
+}
+
+TEST(SpotLimitSizer, InlineFillAndTerminate) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::FillInline;
+    gts::SpotLimitSizer sizer(venue, 1'000);
+    CountingObserver observer;
+    sizer.sendOrder(3, Side::Sell, 1.0, 300, Tif::IOC, observer);
+    EXPECT_EQ(sizer.position(3), -300);
+    EXPECT_EQ(sizer.used(), 300);
+    EXPECT_EQ(observer.terminated, 1);
+}
+
+TEST(SpotLimitSizer, FullOrderTableRefusesBeforeSending) {
+    FakeSender venue;
+    gts::SpotLimitSizer sizer(venue, 1'000'000);
+    CountingObserver observer;
+    for (int i = 0; i < 4096; ++i) {
+        ASSERT_NE(sizer.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+    }
+    EXPECT_EQ(sizer.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(venue.orders.size(), 4096u);
+    EXPECT_EQ(sizer.used(), 4096);
+
+    venue.terminate(venue.orders[0]);
+    EXPECT_NE(sizer.sendOrder(0, Side::Buy, 1.0, 1, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(sizer.used(), 4096);
+}
+
+TEST(SpotLimitSizer, InlineRejectWithoutAckIsRefused) {
+    FakeSender venue;
+    venue.mode = FakeSender::Mode::RejectInline;
+    gts::SpotLimitSizer sizer(venue, 1'000);
+    CountingObserver observer;
+    EXPECT_EQ(sizer.sendOrder(0, Side::Buy, 1.0, 600, Tif::GTC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(sizer.used(), 0);
+    EXPECT_EQ(observer.terminated, 0);
+}
+
+}  // namespace
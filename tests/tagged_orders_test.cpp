@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "fake_sender.hpp"
+#include "gts/tagged_orders.hpp"
+
+namespace {
+
+using gts::Side;
+using gts::Tif;
+using gts::test::FakeSender;
+
+struct Tag {
+    int level;
+    int signal;
+};
+
+struct Recorder : gts::TaggedObserver<Tag> {
+    void onAck(gts::OrderId, Tag& tag) override { acked = tag.level; }
+    void onFill(gts::OrderId, gts::Price, gts::Size size, Tag& tag) override {
+        filledLevel = tag.level;
+        filled += size;
+        ++tag.signal;
+    }
+    void onTerminated(gts::OrderId, Tag& tag) override {
+        terminatedLevel = tag.level;
+        lastSignal = tag.signal;
+    }
+
+    int acked = 0;
+    int filledLevel = 0;
+    int terminatedLevel = 0;
+    int lastSignal = 0;
+    gts::Size filled = 0;
+};
+
+using Sender = gts::TaggedOrderSender<Tag, 4>;
+
+TEST(TaggedOrderSender, CallbacksCarryTheOrdersOwnTag) {
+    FakeSender venue;
+    Sender sender(venue);
+    Recorder first;
+    Recorder second;
+    sender.sendOrder(1, Side::Buy, 1.1, 100, Tif::GTC, first, Tag{1, 10});
+    sender.sendOrder(1, Side::Buy, 1.0, 100, Tif::GTC, second, Tag{2, 20});
+    ASSERT_EQ(venue.orders.size(), 2u);
+
+    venue.ack(venue.orders[1]);
+    venue.ack(venue.orders[0]);
+    EXPECT_EQ(first.acked, 1);
+    EXPECT_EQ(second.acked, 2);
+
+    // The tag is the slot's own copy, so changes made in a callback persist.
+    venue.fill(venue.orders[0], 40);
+    venue.fill(venue.orders[0], 60);
+    venue.terminate(venue.orders[0]);
+    EXPECT_EQ(first.filledLevel, 1);
+    EXPECT_EQ(first.filled, 100);
+    EXPECT_EQ(first.terminatedLevel, 1);
+    EXPECT_EQ(first.lastSignal, 12);
+    EXPECT_EQ(second.filled, 0);
+}
+
+TEST(TaggedOrderSender, SlotsReturnToThePoolOnTermination) {
+    FakeSender venue;
+    Sender sender(venue);
+    Recorder observer;
+    EXPECT_EQ(sender.available(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NE(sender.sendOrder(1, Side::Sell, 1.2, 1, Tif::GTC, observer, Tag{i, 0}),
+                  gts::kInvalidOrderId);
+    }
+    EXPECT_EQ(sender.available(), 0u);
+    EXPECT_EQ(sender.sendOrder(1, Side::Sell, 1.2, 1, Tif::GTC, observer, Tag{9, 0}),
+              gts::kInvalidOrderId);
+    EXPECT_EQ(venue.orders.size(), 4u);
+
+    venue.terminate(venue.orders[2]);
+    EXPECT_EQ(observer.terminatedLevel, 2);
+    EXPECT_EQ(sender.available(), 1u);
+    EXPECT_NE(sender.sendOrder(1, Side::Sell, 1.2, 1, Tif::GTC, observer, Tag{5, 0}),
+              gts::kInvalidOrderId);
+    venue.terminate(venue.orders[4]);
+    EXPECT_EQ(observer.terminatedLevel, 5);
+}
+
+TEST(TaggedOrderSender, RefusedAndInlineOrdersReleaseTheirSlot) {
+    FakeSender venue;
+    Sender sender(venue);
+    Recorder observer;
+    venue.mode = FakeSender::Mode::Refuse;
+    EXPECT_EQ(sender.sendOrder(1, Side::Buy, 1.1, 100, Tif::IOC, observer, Tag{1, 0}),
+              gts::kInvalidOrderId);
+    EXPECT_EQ(sender.available(), 4u);
+
+    venue.mode = FakeSender::Mode::FillInline;
+    EXPECT_NE(sender.sendOrder(1, Side::Buy, 1.1, 100, Tif::IOC, observer, Tag{3, 0}),
+              gts::kInvalidOrderId);
+    EXPECT_EQ(observer.acked, 3);
+    EXPECT_EQ(observer.filledLevel, 3);
+    EXPECT_EQ(observer.terminatedLevel, 3);
+    EXPECT_EQ(sender.available(), 4u);
+}
+
+TEST(TaggedOrderSender, RestoreRebindsTagAndThrowsWhenFull) {
+    FakeSender venue;
+    Sender sender(venue);
+    Recorder observer;
+    sender.reserveOrderIds(100);
+    EXPECT_EQ(venue.nextId, 101);
+
+    gts::SnapshotOrder order{};
+    order.id = 42;
+    order.remaining = 50;
+    for (int i = 0; i < 4; ++i) {
+        sender.restoreOrder(order, observer, Tag{7, 0});
+    }
+    EXPECT_EQ(sender.available(), 0u);
+    EXPECT_THROW(sender.restoreOrder(order, observer, Tag{8, 0}), std::length_error);
+
+    venue.fill(venue.orders[0], 50);
+    EXPECT_EQ(observer.filledLevel, 7);
+}
+
+}  // namespace
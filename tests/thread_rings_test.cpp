@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "gts/thread_rings.hpp"
+
+namespace {
+
+struct Counter {
+    int value = 0;
+};
+
+using Rings = gts::ThreadRings<Counter>;
+
+std::size_t slotCount(Rings& rings) {
+    std::size_t count = 0;
+    rings.forEach([&](Rings::Slot&) { ++count; });
+    return count;
+}
+
+TEST(ThreadRings, SameThreadGetsSameSlot) {
+    Rings rings;
+    Rings::Slot& first = rings.local();
+    EXPECT_EQ(&rings.local(), &first);
+    EXPECT_EQ(first.index, 0u);
+    EXPECT_EQ(slotCount(rings), 1u);
+}
+
+TEST(ThreadRings, AlternatingOwnersDoNotReallocate) {
+    // More owners than the thread-local cache holds.
+    std::vector<std::unique_ptr<Rings>> owners;
+    for (int i = 0; i < 9; ++i) owners.push_back(std::make_unique<Rings>());
+    for (int round = 0; round < 5; ++round) {
+        for (auto& owner : owners) ++owner->local().ring.value;
+    }
+    for (auto& owner : owners) {
+        EXPECT_EQ(slotCount(*owner), 1u);
+        EXPECT_EQ(owner->local().ring.value, 5);
+    }
+}
+
+TEST(ThreadRings, ReusedAddressGetsFreshSlot) {
+    alignas(Rings) unsigned char storage[sizeof(Rings)];
+    Rings* first = new (storage) Rings;
+    first->local().ring.value = 42;
+    first->~Rings();
+    Rings* second = new (storage) Rings;
+    EXPECT_EQ(second->local().ring.value, 0);
+    EXPECT_EQ(slotCount(*second), 1u);
+    second->~Rings();
+}
+
+TEST(ThreadRings, ThreadsGetDistinctSlots) {
+    Rings rings;
+    rings.local();
+    std::thread other([&] { EXPECT_EQ(rings.local().index, 1u); });
+    other.join();
+    EXPECT_EQ(rings.local().index, 0u);
+    EXPECT_EQ(slotCount(rings), 2u);
+}
+
+TEST(ThreadRings, ThreadCanRegisterWhileConsumerVisits) {
+    Rings rings;
+    rings.local();
+    std::size_t visited = 0;
+    rings.forEach([&](Rings::Slot&) {
+        // A consumer writing out a slot must not hold up registration.
+        std::thread producer([&] { rings.local(); });
+        producer.join();
+        ++visited;
+    });
+    EXPECT_EQ(visited, 1u);
+    EXPECT_EQ(slotCount(rings), 2u);
+}
+
+}  // namespace
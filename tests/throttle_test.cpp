@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "fake_sender.hpp"
+#include "gts/throttle.hpp"
+
+namespace {
+
+using gts::MessageKind;
+
+constexpr gts::Timestamp kSecond = 1'000'000'000;
+
+TEST(Throttle, BurstThenRefill) {
+    gts::Throttle throttle(10, 3, 0, 0);
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_FALSE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_EQ(throttle.waitTime(MessageKind::New, 0), kSecond / 10);
+    EXPECT_TRUE(throttle.canSend(MessageKind::New, kSecond / 10));
+    EXPECT_EQ(throttle.throttled(), 1u);
+}
+
+TEST(Throttle, ReserveIsLeftForCancels) {
+    gts::Throttle throttle(10, 2, 1, 0);
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_FALSE(throttle.canSend(MessageKind::New, 0));
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::Cancel, 0));
+}
+
+TEST(Throttle, LongIdleDoesNotOverflow) {
+    gts::Throttle throttle(1'000'000, 100, 1, 0);
+    for (int i = 0; i < 100; ++i) throttle.tryConsume(MessageKind::Cancel, 0);
+    const gts::Timestamp threeHours = 3 * 3600 * kSecond;
+    EXPECT_TRUE(throttle.canSend(MessageKind::New, threeHours));
+}
+
+TEST(Throttle, EpochStartThenWallClock) {
+    gts::Throttle throttle(1'000'000, 100, 1, 0);
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 1'700'000'000 * kSecond));
+    EXPECT_TRUE(throttle.canSend(MessageKind::New, 1'700'000'000 * kSecond));
+}
+
+TEST(Throttle, ZeroRateIsRejected) {
+    EXPECT_THROW(gts::Throttle(0, 1, 0, 0), std::invalid_argument);
+}
+
+TEST(Throttle, RefundIsCappedAtBurst) {
+    gts::Throttle throttle(10, 2, 0, 0);
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    throttle.refund();
+    throttle.refund();
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_TRUE(throttle.tryConsume(MessageKind::New, 0));
+    EXPECT_FALSE(throttle.tryConsume(MessageKind::New, 0));
+}
+
+TEST(ThrottledOrderSender, RefusedFurtherInKeepsToken) {
+    gts::test::FakeSender venue;
+    venue.mode = gts::test::FakeSender::Mode::Refuse;
+    gts::Throttle throttle(1, 1, 0);
+    gts::ThrottledOrderSender sender(venue, throttle);
+    gts::test::CountingObserver observer;
+    EXPECT_EQ(sender.sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::IOC, observer), gts::kInvalidOrderId);
+    EXPECT_TRUE(sender.canSend());
+    venue.mode = gts::test::FakeSender::Mode::Open;
+    EXPECT_NE(sender.sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::IOC, observer), gts::kInvalidOrderId);
+}
+
+TEST(ThrottledOrderSender, RefusesOverRate) {
+    gts::test::FakeSender venue;
+    gts::Throttle throttle(1, 1, 0);
+    gts::ThrottledOrderSender sender(venue, throttle);
+    gts::test::CountingObserver observer;
+    EXPECT_NE(sender.sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::IOC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(sender.sendOrder(0, gts::Side::Buy, 1.0, 1, gts::Tif::IOC, observer), gts::kInvalidOrderId);
+    EXPECT_EQ(venue.orders.size(), 1u);
+}
+
+}  // namespace
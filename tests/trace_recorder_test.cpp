@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fake_sender.hpp"
+#include "gts/trace_recorder.hpp"
+
+namespace {
+
+std::vector<gts::TraceRecord> readTrace(const std::string& path) {
+    std::vector<gts::TraceRecord> records;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) return records;
+    gts::TraceFileHeader header{};
+    if (std::fread(&header, sizeof(header), 1, file) == 1) {
+        gts::TraceRecord rec;
+        while (std::fread(&rec, sizeof(rec), 1, file) == 1) records.push_back(rec);
+    }
+    std::fclose(file);
+    return records;
+}
+
+std::string tracePath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+TEST(TraceRecorder, WritesRecordsInOrder) {
+    const std::string path = tracePath("trace_order.bin");
+    {
+        gts::TraceRecorder recorder(path);
+        recorder.record(100, gts::TraceEventType::Send, 7, 3, gts::Side::Sell, gts::Tif::IOC, 1.25, 1'000);
+        recorder.record(200, gts::TraceEventType::Ack, 7, 3, gts::Side::Sell, gts::Tif::IOC, 0, 0);
+    }
+    const std::vector<gts::TraceRecord> records = readTrace(path);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].type, gts::TraceEventType::Send);
+    EXPECT_EQ(records[0].orderId, 7u);
+    EXPECT_EQ(records[0].pair, 3);
+    EXPECT_EQ(records[0].size, 1'000);
+    EXPECT_EQ(records[1].type, gts::TraceEventType::Ack);
+    EXPECT_EQ(records[1].timestamp, 200);
+}
+
+TEST(TraceRecorder, WritesBatchesLargerThanTheFlushBuffer) {
+    const std::string path = tracePath("trace_large.bin");
+    {
+        gts::TraceRecorder recorder(path);
+        for (gts::OrderId id = 1; id <= 10'000; ++id) {
+            recorder.record(gts::TraceEventType::Ack, id);
+        }
+    }
+    const std::vector<gts::TraceRecord> records = readTrace(path);
+    ASSERT_EQ(records.size(), 10'000u);
+    EXPECT_EQ(records.back().orderId, 10'000u);
+}
+
+TEST(TracingOrderSender, RecordsOnlyAcceptedSends) {
+    const std::string path = tracePath("trace_sends.bin");
+    {
+        gts::TraceRecorder recorder(path);
+        gts::test::FakeSender venue;
+        gts::TracingOrderSender sender(venue, recorder);
+        gts::test::CountingObserver observer;
+        venue.mode = gts::test::FakeSender::Mode::Refuse;
+        EXPECT_EQ(sender.sendOrder(1, gts::Side::Buy, 1.1, 5, gts::Tif::IOC, observer),
+                  gts::kInvalidOrderId);
+        venue.mode = gts::test::FakeSender::Mode::Open;
+        EXPECT_EQ(sender.sendOrder(1, gts::Side::Buy, 1.1, 5, gts::Tif::IOC, observer), 1u);
+    }
+    const std::vector<gts::TraceRecord> records = readTrace(path);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].orderId, 1u);
+    EXPECT_EQ(records[0].type, gts::TraceEventType::Send);
+}
+
+TEST(TraceRecorder, ThreadCanFeedSeveralRecorders) {
+    const std::string pathA = tracePath("trace_a.bin");
+    const std::string pathB = tracePath("trace_b.bin");
+    {
+        gts::TraceRecorder a(pathA);
+        gts::TraceRecorder b(pathB);
+        for (gts::OrderId id = 1; id <= 100; ++id) {
+            a.record(gts::TraceEventType::Ack, id);
+            b.record(gts::TraceEventType::Fill, id + 1000, 1.0, 1);
+        }
+    }
+    const std::vector<gts::TraceRecord> a = readTrace(pathA);
+    const std::vector<gts::TraceRecord> b = readTrace(pathB);
+    ASSERT_EQ(a.size(), 100u);
+    ASSERT_EQ(b.size(), 100u);
+    EXPECT_EQ(a.back().orderId, 100u);
+    EXPECT_EQ(b.back().type, gts::TraceEventType::Fill);
+    EXPECT_EQ(a.front().threadId, 0u);
+}
+
+}  // namespace
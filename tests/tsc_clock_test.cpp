@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include "gts/clock.hpp"
+#include "gts/tsc_clock.hpp"
+
+namespace {
+
+constexpr gts::Timestamp kMillisecond = 1'000'000;
+
+TEST(TscClock, TracksRealtime) {
+    gts::initClock();
+    EXPECT_LT(std::llabs(gts::nowNanos() - gts::realtimeNanos()), 5 * kMillisecond);
+}
+
+TEST(TscClock, IsMonotonicAcrossRecalibration) {
+    gts::TscClock& clock = gts::TscClock::instance();
+    gts::Timestamp last = clock.now();
+    for (int i = 0; i < 20; ++i) {
+        clock.recalibrate(std::chrono::milliseconds(10));
+        const gts::Timestamp now = clock.now();
+        EXPECT_GE(now, last);
+        last = now;
+    }
+}
+
+TEST(TscClock, RecalibrationBoundsRateChange) {
+    gts::TscClock& clock = gts::TscClock::instance();
+    if (!clock.usable()) GTEST_SKIP() << "no invariant TSC";
+    for (int i = 0; i < 5; ++i) {
+        const double before = clock.ticksPerNano();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        clock.recalibrate(std::chrono::milliseconds(1));
+        // Measured rate and slew are each capped at 0.05%.
+        EXPECT_NEAR(clock.ticksPerNano() / before, 1.0, 0.0011);
+    }
+}
+
+}  // namespace
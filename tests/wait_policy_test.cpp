@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "gts/clock.hpp"
+#include "gts/wait_policy.hpp"
+
+namespace {
+
+using gts::WaitState;
+
+std::uint64_t waits(const gts::AdaptiveWaitPolicy& policy, WaitState state) {
+    return policy.stats().waits[static_cast<std::size_t>(state)];
+}
+
+TEST(AdaptiveWaitPolicy, EscalatesWithIdleTime) {
+    gts::AdaptiveWaitPolicy policy;
+    const gts::Timestamp spin = policy.spinThreshold();
+    const gts::Timestamp start = gts::nowNanos();
+    policy.idle(start);
+    policy.idle(start + spin - 1);
+    EXPECT_EQ(waits(policy, WaitState::Spin), 2u);
+    policy.idle(start + spin);
+    EXPECT_EQ(waits(policy, WaitState::Pause), 1u);
+    policy.idle(start + 4 * spin);
+    EXPECT_EQ(waits(policy, WaitState::Yield), 1u);
+    policy.idle(start + 16 * spin);
+    EXPECT_EQ(waits(policy, WaitState::Sleep), 1u);
+
+    // Activity starts the escalation over.
+    policy.onActivity(start + 16 * spin);
+    policy.idle(start + 100 * spin);
+    EXPECT_EQ(waits(policy, WaitState::Spin), 3u);
+}
+
+TEST(AdaptiveWaitPolicy, SpinsAcrossShortGaps) {
+    gts::AdaptiveWaitPolicy policy;
+    gts::Timestamp now = 1;
+    for (int i = 0; i < 400; ++i) policy.onActivity(now += 10'000);
+    EXPECT_NEAR(static_cast<double>(policy.gapEstimate()), 10'000, 100);
+    EXPECT_NEAR(static_cast<double>(policy.spinThreshold()), 20'000, 200);
+}
+
+TEST(AdaptiveWaitPolicy, SpinsBrieflyWhenGapsExceedTheBudget) {
+    gts::AdaptiveWaitPolicy::Limits limits;
+    gts::AdaptiveWaitPolicy policy(limits);
+    gts::Timestamp now = 1;
+    for (int i = 0; i < 400; ++i) policy.onActivity(now += 10'000'000);
+    EXPECT_EQ(policy.spinThreshold(), limits.minSpin);
+}
+
+TEST(RunEventLoop, RunsUntilStopped) {
+    gts::AdaptiveWaitPolicy policy;
+    std::atomic<bool> running{true};
+    int polls = 0;
+    gts::runEventLoop(
+        [&] {
+            if (++polls == 10) running = false;
+            return polls % 2;
+        },
+        policy, running);
+    EXPECT_EQ(polls, 10);
+    EXPECT_EQ(waits(policy, WaitState::Spin) + waits(policy, WaitState::Pause) +
+                  waits(policy, WaitState::Yield) + waits(policy, WaitState::Sleep),
+              5u);
+}
+
+}  // namespace
@@ -0,0 +1,166 @@
+// Multi-day backtest over recorded tick files.
+//
+// Usage: backtest [--threads <n>] [--carry] <ticks.bin>...
+//        backtest --generate <out.bin> [--ticks <count>] [--pairs <n>] [--seed <n>]
+//
+// Each file is one shard. By default shards replay in parallel, one per
+// worker thread, each with its own strategy and simulated exchange, and the
+// per-shard results are summed. With --carry the files replay in the order
+// given through a single strategy, with the next file loaded in the
+// background. --generate writes a synthetic random-walk tick file.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gts/fair_value.hpp"
+#include "gts/replay.hpp"
+
+namespace {
+
+// Takes the touch with an IOC when the book is lopsided, within a fixed
+// position limit per pair.
+class ImbalanceTaker : public gts::Strategy, public gts::OrderStateObserver {
+public:
+    explicit ImbalanceTaker(gts::OrderSender& sender) : sender_(sender) {}
+
+    void postEvent(const gts::Event& event) override {
+        fairValue_.onEvent(event);
+        const gts::Fixed imbalance = fairValue_.value(event.pair).imbalance;
+        const gts::Size position = positions_[event.pair];
+        pair_ = event.pair;
+        if (imbalance > kThreshold && position < kLimit) {
+            side_ = gts::Side::Buy;
+            sender_.sendOrder(event.pair, side_, event.askPrice, kClip, gts::Tif::IOC, *this);
+        } else if (imbalance < -kThreshold && position > -kLimit) {
+            side_ = gts::Side::Sell;
+            sender_.sendOrder(event.pair, side_, event.bidPrice, kClip, gts::Tif::IOC, *this);
+        }
+    }
+
+    // IOC fills arrive inline, so the pair and side of the order in flight
+    // are still current.
+    void onAck(gts::OrderId) override {}
+    void onFill(gts::OrderId, gts::Price price, gts::Size size) override {
+        positions_[pair_] += side_ == gts::Side::Buy ? size : -size;
+        fairValue_.onFill(pair_, side_, gts::Tif::IOC, price, size);
+    }
+    void onTerminated(gts::OrderId) override {}
+
+private:
+    static constexpr gts::Fixed kThreshold = gts::kFixedScale / 2;
+    static constexpr gts::Size kLimit = 1'000'000;
+    static constexpr gts::Size kClip = 100'000;
+
+    gts::OrderSender& sender_;
+    gts::FairValueEngine fairValue_;
+    gts::Size positions_[gts::kMaxPairs]{};
+    gts::PairId pair_ = 0;
+    gts::Side side_ = gts::Side::Buy;
+};
+
+void generate(const char* path, std::uint64_t ticks, unsigned pairs, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> step(0.0, 0.00002);
+    std::uniform_int_distribution<gts::Size> size(1, 50);
+    std::vector<double> mids(pairs, 1.1);
+    gts::TickFileWriter writer(path);
+    for (std::uint64_t i = 0; i < ticks; ++i) {
+        const auto pair = static_cast<gts::PairId>(i % pairs);
+        mids[pair] += step(rng);
+        writer.append(gts::Event{static_cast<gts::Timestamp>(i) * 1'000, pair, mids[pair] - 0.00001,
+                                 size(rng) * 100'000, mids[pair] + 0.00001, size(rng) * 100'000});
+    }
+    writer.close();
+}
+
+void print(const char* name, const gts::BacktestResult& r) {
+    std::printf("%-10s events=%" PRIu64 " orders=%" PRIu64 " fills=%" PRIu64 " volume=%" PRId64
+                " equity=%.2f\n",
+                name, r.events, r.orders, r.fills, r.volume, r.equity);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = std::thread::hardware_concurrency();
+    bool carry = false;
+    const char* generatePath = nullptr;
+    std::uint64_t ticks = 1'000'000;
+    unsigned pairs = 3;
+    unsigned seed = 1;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--carry") == 0) {
+            carry = true;
+        } else if (std::strcmp(argv[i], "--generate") == 0 && hasValue) {
+            generatePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--pairs") == 0 && hasValue) {
+            pairs = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (argv[i][0] != '-') {
+            paths.emplace_back(argv[i]);
+        } else {
+            paths.clear();
+            break;
+        }
+    }
+    if (generatePath != nullptr) {
+        if (pairs == 0 || pairs > gts::kMaxPairs) {
+            std::fprintf(stderr, "--pairs must be 1..%u\n", static_cast<unsigned>(gts::kMaxPairs));
+            return 2;
+        }
+        try {
+            generate(generatePath, ticks, pairs, seed);
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+    if (paths.empty()) {
+        std::fprintf(stderr,
+                     "usage: %s [--threads <n>] [--carry] <ticks.bin>...\n"
+                     "       %s --generate <out.bin> [--ticks <count>] [--pairs <n>] [--seed <n>]\n",
+                     argv[0], argv[0]);
+        return 2;
+    }
+
+    const gts::StrategyFactory factory = [](gts::OrderSender& sender, std::size_t) {
+        return std::make_unique<ImbalanceTaker>(sender);
+    };
+    const auto start = std::chrono::steady_clock::now();
+    gts::BacktestResult total;
+    try {
+        if (carry) {
+            total = gts::runSequential(paths, factory);
+        } else {
+            const std::vector<gts::BacktestResult> shards = gts::runSharded(paths, factory, threads);
+            for (std::size_t i = 0; i < shards.size(); ++i) {
+                print(("shard " + std::to_string(i)).c_str(), shards[i]);
+                total += shards[i];
+            }
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print("total", total);
+    std::printf("%.3f s, %.1f M events/s\n", seconds, static_cast<double>(total.events) / seconds / 1e6);
+    return 0;
+}
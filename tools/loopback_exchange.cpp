@@ -0,0 +1,171 @@
+// Stand-in venue for latency testing over a local socket.
+//
+// Usage: loopback_exchange [--port <port>] [--rate <ticks/s>] [--ticks <count>] [--pairs <n>]
+//
+// Accepts one client, publishes synthetic ticks at a fixed rate with the
+// send time embedded in Event::timestamp, and answers every order with an
+// ack (carrying the venue receive time), a full fill and a termination.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gts/clock.hpp"
+#include "gts/wire.hpp"
+
+namespace {
+
+bool writeAll(int fd, const void* data, std::size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+int listenOn(std::uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 1) != 0) {
+        std::perror("bind/listen");
+        std::exit(1);
+    }
+    return fd;
+}
+
+// Ack, fill and termination go out in a single write.
+void answer(int fd, const gts::wire::NewOrder& order, gts::Timestamp received) {
+    using gts::wire::MsgType;
+    const auto header = gts::wire::header<gts::wire::OrderUpdate>(MsgType::Ack);
+    gts::wire::OrderUpdate updates[3] = {
+        {header, order.clientId, order.triggerTimestamp, received, 0, 0},
+        {header, order.clientId, order.triggerTimestamp, received, order.price, order.size},
+        {header, order.clientId, order.triggerTimestamp, received, 0, 0},
+    };
+    updates[1].header.type = MsgType::Fill;
+    updates[2].header.type = MsgType::Terminated;
+    writeAll(fd, updates, sizeof(updates));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::uint16_t port = 9555;
+    double rate = 10'000;
+    std::uint64_t tickCount = 100'000;
+    unsigned pairs = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--port") == 0) {
+            port = static_cast<std::uint16_t>(std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--rate") == 0) {
+            rate = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--ticks") == 0) {
+            tickCount = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--pairs") == 0) {
+            pairs = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        } else {
+            std::fprintf(stderr, "usage: %s [--port <port>] [--rate <ticks/s>] "
+                                 "[--ticks <count>] [--pairs <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    gts::initClock();
+    const int listener = listenOn(port);
+    std::fprintf(stderr, "loopback_exchange: listening on 127.0.0.1:%u\n", port);
+    const int fd = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (fd < 0) {
+        std::perror("accept");
+        return 1;
+    }
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    const auto interval = static_cast<gts::Timestamp>(1e9 / rate);
+    gts::Timestamp nextTick = gts::nowNanos();
+    std::uint64_t sent = 0;
+    std::uint64_t orders = 0;
+    gts::Timestamp drainUntil = 0;
+    std::vector<char> buffer(1 << 16);
+    std::size_t filled = 0;
+
+    for (;;) {
+        const gts::Timestamp now = gts::nowNanos();
+        if (sent < tickCount && now >= nextTick) {
+            const double move = static_cast<double>(sent % 23) * 1e-5;
+            gts::wire::Tick tick{gts::wire::header<gts::wire::Tick>(gts::wire::MsgType::Tick), sent,
+                                 gts::Event{0, static_cast<gts::PairId>(sent % pairs),
+                                            1.1000 + move, 1'000'000, 1.1002 + move, 1'000'000}};
+            tick.event.timestamp = gts::nowNanos();
+            if (!writeAll(fd, &tick, sizeof(tick))) {
+                break;
+            }
+            nextTick += interval;
+            if (++sent == tickCount) {
+                drainUntil = tick.event.timestamp + 100'000'000;
+            }
+        }
+        if (sent == tickCount && now >= drainUntil) {
+            break;
+        }
+
+        const ssize_t n = ::recv(fd, buffer.data() + filled, buffer.size() - filled, MSG_DONTWAIT);
+        if (n == 0) {
+            break;
+        }
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                continue;
+            }
+            std::perror("recv");
+            break;
+        }
+        const gts::Timestamp received = gts::nowNanos();
+        filled += static_cast<std::size_t>(n);
+        std::size_t offset = 0;
+        bool malformed = false;
+        while (filled - offset >= sizeof(gts::wire::NewOrder)) {
+            gts::wire::NewOrder order;
+            std::memcpy(&order, buffer.data() + offset, sizeof(order));
+            if (order.header.type != gts::wire::MsgType::NewOrder ||
+                order.header.length != sizeof(order)) {
+                malformed = true;
+                break;
+            }
+            offset += sizeof(order);
+            answer(fd, order, received);
+            ++orders;
+        }
+        if (malformed) {
+            std::fprintf(stderr, "loopback_exchange: malformed frame, closing\n");
+            break;
+        }
+        std::memmove(buffer.data(), buffer.data() + offset, filled - offset);
+        filled -= offset;
+    }
+
+    ::close(fd);
+    std::fprintf(stderr, "loopback_exchange: %" PRIu64 " ticks, %" PRIu64 " orders\n", sent, orders);
+    return 0;
+}
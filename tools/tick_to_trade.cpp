@@ -0,0 +1,90 @@
+// Wire-to-wire tick-to-trade latency harness.
+//
+// Usage: tick_to_trade [--port <port>] [--every <n>]
+//
+// Connects to loopback_exchange, runs a strategy that sends an IOC order
+// from postEvent() on every n-th tick, and reports the time from the venue
+// writing the tick to the venue reading the order. Both ends of each sample
+// are taken on the venue clock.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gts/clock.hpp"
+#include "gts/socket_session.hpp"
+
+namespace {
+
+class IocTaker : public gts::Strategy, public gts::OrderStateObserver {
+public:
+    IocTaker(gts::OrderSender& sender, std::uint64_t every) : sender_(sender), every_(every) {}
+
+    void postEvent(const gts::Event& event) override {
+        if (++ticks_ % every_ == 0) {
+            sender_.sendOrder(event.pair, gts::Side::Buy, event.askPrice, 1'000, gts::Tif::IOC, *this);
+        }
+    }
+
+    void onAck(gts::OrderId) override {}
+    void onFill(gts::OrderId, gts::Price, gts::Size) override {}
+    void onTerminated(gts::OrderId) override {}
+
+private:
+    gts::OrderSender& sender_;
+    std::uint64_t every_;
+    std::uint64_t ticks_ = 0;
+};
+
+void report(std::vector<gts::Timestamp>& samples) {
+    if (samples.empty()) {
+        std::printf("no samples\n");
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))];
+    };
+    std::printf("tick-to-order (ns) n=%zu\n", samples.size());
+    std::printf("  min     %10" PRId64 "\n", samples.front());
+    std::printf("  p50     %10" PRId64 "\n", at(0.50));
+    std::printf("  p90     %10" PRId64 "\n", at(0.90));
+    std::printf("  p99     %10" PRId64 "\n", at(0.99));
+    std::printf("  p99.9   %10" PRId64 "\n", at(0.999));
+    std::printf("  p99.99  %10" PRId64 "\n", at(0.9999));
+    std::printf("  max     %10" PRId64 "\n", samples.back());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::uint16_t port = 9555;
+    std::uint64_t every = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--port") == 0) {
+            port = static_cast<std::uint16_t>(std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--every") == 0) {
+            every = std::max<std::uint64_t>(1, std::strtoull(argv[i + 1], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "usage: %s [--port <port>] [--every <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    gts::initClock();
+    gts::SocketSession session("127.0.0.1", port);
+    std::vector<gts::Timestamp> samples;
+    samples.reserve(1 << 20);
+    session.setReceiptHandler([&](gts::Timestamp trigger, gts::Timestamp received) {
+        samples.push_back(received - trigger);
+    });
+
+    IocTaker strategy(session, every);
+    while (session.poll(strategy)) {
+    }
+    report(samples);
+    return 0;
+}
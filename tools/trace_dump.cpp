@@ -0,0 +1,128 @@
+// Offline reader for TraceRecorder binary logs.
+//
+// Usage: trace_dump <trace.bin> [--timelines]
+//
+// Reconstructs per-order timelines and prints aggregate send->ack,
+// send->first fill and send->terminated latency percentiles.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "gts/trace_recorder.hpp"
+
+namespace {
+
+struct Timeline {
+    std::vector<gts::TraceRecord> events;
+};
+
+const char* typeName(gts::TraceEventType type) {
+    switch (type) {
+        case gts::TraceEventType::Send: return "send";
+        case gts::TraceEventType::Ack: return "ack";
+        case gts::TraceEventType::Fill: return "fill";
+        case gts::TraceEventType::Terminated: return "terminated";
+    }
+    return "?";
+}
+
+void printPercentiles(const char* name, std::vector<gts::Timestamp>& samples) {
+    if (samples.empty()) {
+        std::printf("%-16s n=0\n", name);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        return samples[static_cast<std::size_t>(q * (samples.size() - 1))];
+    };
+    std::printf("%-16s n=%zu min=%" PRId64 " p50=%" PRId64 " p90=%" PRId64
+                " p99=%" PRId64 " p99.9=%" PRId64 " max=%" PRId64 " (ns)\n",
+                name, samples.size(), samples.front(), at(0.5), at(0.9), at(0.99),
+                at(0.999), samples.back());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace.bin> [--timelines]\n", argv[0]);
+        return 2;
+    }
+    const bool timelines = argc > 2 && std::strcmp(argv[2], "--timelines") == 0;
+
+    std::FILE* file = std::fopen(argv[1], "rb");
+    if (file == nullptr) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    gts::TraceFileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, gts::kTraceMagic, sizeof(header.magic)) != 0 ||
+        header.version != gts::kTraceVersion || header.recordSize != sizeof(gts::TraceRecord)) {
+        std::fprintf(stderr, "%s: not a trace file or incompatible version\n", argv[1]);
+        std::fclose(file);
+        return 1;
+    }
+
+    // Records from different threads are interleaved by flush order, so
+    // group by order and sort each timeline by timestamp.
+    std::map<gts::OrderId, Timeline> orders;
+    gts::TraceRecord rec;
+    std::size_t total = 0;
+    while (std::fread(&rec, sizeof(rec), 1, file) == 1) {
+        orders[rec.orderId].events.push_back(rec);
+        ++total;
+    }
+    std::fclose(file);
+
+    std::vector<gts::Timestamp> toAck, toFill, toTerminated;
+    for (auto& [id, timeline] : orders) {
+        auto& events = timeline.events;
+        std::stable_sort(events.begin(), events.end(),
+                         [](const auto& a, const auto& b) { return a.timestamp < b.timestamp; });
+        const gts::TraceRecord* send = nullptr;
+        bool filled = false;
+        for (const auto& ev : events) {
+            switch (ev.type) {
+                case gts::TraceEventType::Send:
+                    send = &ev;
+                    break;
+                case gts::TraceEventType::Ack:
+                    if (send) toAck.push_back(ev.timestamp - send->timestamp);
+                    break;
+                case gts::TraceEventType::Fill:
+                    if (send && !filled) toFill.push_back(ev.timestamp - send->timestamp);
+                    filled = true;
+                    break;
+                case gts::TraceEventType::Terminated:
+                    if (send) toTerminated.push_back(ev.timestamp - send->timestamp);
+                    break;
+            }
+        }
+        if (timelines) {
+            std::printf("order %" PRIu64 "\n", id);
+            for (const auto& ev : events) {
+                std::printf("  %" PRId64 " %-10s thread=%u", ev.timestamp, typeName(ev.type),
+                            ev.threadId);
+                if (ev.type == gts::TraceEventType::Send) {
+                    std::printf(" pair=%u side=%s tif=%s price=%.10g size=%" PRId64, ev.pair,
+                                ev.side == gts::Side::Buy ? "buy" : "sell",
+                                ev.tif == gts::Tif::GTC ? "GTC" : "IOC", ev.price, ev.size);
+                } else if (ev.type == gts::TraceEventType::Fill) {
+                    std::printf(" price=%.10g size=%" PRId64, ev.price, ev.size);
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    std::printf("%zu records, %zu orders\n", total, orders.size());
+    printPercentiles("send->ack", toAck);
+    printPercentiles("send->first fill", toFill);
+    printPercentiles("send->terminated", toTerminated);
+    return 0;
+}